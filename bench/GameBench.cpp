@@ -0,0 +1,485 @@
+// Benchmarks for the simulation and rendering hot paths: microbenchmarks
+// over collisions, AI, bullets, snapshots, particles, sprites and text at several
+// sizes, and headless macro scenarios (scripted waves, recorded replays),
+// which are timed per whole run. Prints a table and writes every case as JSON with
+// its median and variance, so runs from different commits can be diffed.
+// Usage: game_bench [output.json] [--samples n] [--label text] [--threads n] [--replay path]...
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Game.h"
+
+using namespace std;
+
+namespace {
+
+const int SIZES[] = {10, 100, 1000};
+const float TICK = 1.0f / SIMULATION_TICK_RATE;
+
+struct BenchResult {
+    string name;
+    vector<double> samples; // Microseconds per operation
+    double median, mean, variance, min, max;
+};
+
+double elapsedUs(Uint64 start) {
+    return (SDL_GetPerformanceCounter() - start) * 1e6 / SDL_GetPerformanceFrequency();
+}
+
+// Quotes, backslashes and control characters escaped for a JSON string
+string jsonEscape(const string& text) {
+    string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// Collects timings and writes them out once every case has run
+class BenchSuite {
+private:
+    vector<BenchResult> results;
+
+public:
+    int samples = 30;
+
+    // Each sample times reps calls of body, each after an untimed setup,
+    // and records the average per call
+    void measure(const string& name, int reps, const function<void()>& setup, const function<void()>& body) {
+        // One untimed pass to warm caches and grow any lazily sized buffers
+        setup();
+        body();
+
+        BenchResult result;
+        result.name = name;
+        for (int s = 0; s < samples; ++s) {
+            double total = 0.0;
+            for (int r = 0; r < reps; ++r) {
+                setup();
+                Uint64 start = SDL_GetPerformanceCounter();
+                body();
+                total += elapsedUs(start);
+            }
+            result.samples.push_back(total / reps);
+        }
+        add(result);
+    }
+
+    void add(BenchResult result) {
+        vector<double> sorted = result.samples;
+        sort(sorted.begin(), sorted.end());
+        size_t n = sorted.size();
+        result.median = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+        result.min = sorted.front();
+        result.max = sorted.back();
+
+        double sum = 0.0;
+        for (double sample : sorted) {
+            sum += sample;
+        }
+        result.mean = sum / n;
+        double squares = 0.0;
+        for (double sample : sorted) {
+            squares += (sample - result.mean) * (sample - result.mean);
+        }
+        result.variance = n > 1 ? squares / (n - 1) : 0.0;
+
+        printf("%-28s median %10.2f us  stddev %8.2f us  min %10.2f us\n",
+               result.name.c_str(), result.median, sqrt(result.variance), result.min);
+        results.push_back(result);
+    }
+
+    bool writeJson(const string& path, const string& label) const {
+        FILE* file = fopen(path.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "Unable to write benchmark results %s!\n", path.c_str());
+            return false;
+        }
+        fprintf(file, "{\n  \"label\": \"%s\",\n  \"unit\": \"us\",\n  \"cases\": [\n", jsonEscape(label).c_str());
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchResult& r = results[i];
+            fprintf(file, "    {\"name\": \"%s\", \"samples\": %zu, \"median\": %.4f, \"variance\": %.4f, "
+                          "\"mean\": %.4f, \"min\": %.4f, \"max\": %.4f}%s\n",
+                    jsonEscape(r.name).c_str(), r.samples.size(), r.median, r.variance, r.mean, r.min, r.max,
+                    i + 1 < results.size() ? "," : "");
+        }
+        fprintf(file, "  ]\n}\n");
+        fclose(file);
+        return true;
+    }
+};
+
+} // namespace
+
+// Friend of Game: builds worlds of a given size and calls the private update
+// steps on them. Fixed seeds keep every run of a case on the same workload.
+class GameBench {
+public:
+    static unique_ptr<Game> makeGame(Uint64 seed) {
+        unique_ptr<Game> game(new Game());
+        game->headless = true;
+        game->setClock(&game->simulationClock);
+        game->setSeed(seed);
+        game->state = GameState::PLAYING;
+        game->reset();
+        return game;
+    }
+
+    // enemyCount tanks and bulletCount bullets spread over the map, mostly
+    // player bullets so the enemy grid does the work
+    static void populate(Game& game, int enemyCount, int bulletCount, Uint64 seed) {
+        Rng rng(seed);
+        game.enemies.clear();
+        for (int i = 0; i < enemyCount; ++i) {
+            float x = rng.uniform(BORDER_OFFSET, MAP_WIDTH - BORDER_OFFSET);
+            float y = rng.uniform(BORDER_OFFSET, MAP_HEIGHT - BORDER_OFFSET);
+            game.enemies.spawn(x, y, static_cast<EnemyType>(i % 3));
+        }
+
+        game.bullets.clear();
+        for (int i = 0; i < bulletCount; ++i) {
+            float angle = rng.uniform(0.0f, 2.0f * M_PI);
+            game.bullets.spawn(rng.uniform(BORDER_OFFSET, MAP_WIDTH - BORDER_OFFSET),
+                               rng.uniform(BORDER_OFFSET, MAP_HEIGHT - BORDER_OFFSET),
+                               BULLET_SPEED * cos(angle), BULLET_SPEED * sin(angle), i % 4 == 0);
+        }
+    }
+
+    static void collisions(BenchSuite& suite) {
+        for (int size : SIZES) {
+            unique_ptr<Game> game = makeGame(1);
+            populate(*game, size, size, 2);
+            const EnemyPool enemies = game->enemies;
+            const BulletPool bullets = game->bullets;
+            const Tank player = game->player;
+
+            suite.measure("collisions/" + to_string(size), max(1, 2000 / size),
+                [&] {
+                    game->enemies = enemies;
+                    game->bullets = bullets;
+                    game->player = player;
+                    game->particles.clear();
+                    game->explosions.clear();
+                    game->killNotifications.clear();
+                },
+                [&] { game->handleCollisions(); });
+        }
+    }
+
+    static void enemyBehavior(BenchSuite& suite) {
+        for (int size : SIZES) {
+            unique_ptr<Game> game = makeGame(3);
+            populate(*game, size, 0, 4);
+            const EnemyPool enemies = game->enemies;
+
+            suite.measure("ai/updateEnemies/" + to_string(size), max(1, 2000 / size),
+                [&] {
+                    game->enemies = enemies;
+                    game->bullets.clear();
+                    game->particles.clear();
+                },
+                [&] { game->updateEnemies(TICK); });
+        }
+    }
+
+    static void bulletUpdate(BenchSuite& suite) {
+        for (int size : SIZES) {
+            unique_ptr<Game> game = makeGame(5);
+            populate(*game, 0, size, 6);
+            const BulletPool bullets = game->bullets;
+
+            suite.measure("bullets/update/" + to_string(size), max(1, 20000 / size),
+                [&] { game->bullets = bullets; },
+                [&] { game->bullets.update(TICK); });
+        }
+    }
+
+    // Copying a tick's world into the render snapshot, enemies and bullets alike
+    static void snapshotPublish(BenchSuite& suite) {
+        for (int size : SIZES) {
+            unique_ptr<Game> game = makeGame(9);
+            populate(*game, size, size, 10);
+
+            suite.measure("snapshot/publish/" + to_string(size), max(1, 2000 / size),
+                [] {},
+                [&] { game->publishSnapshot(0.0f); });
+        }
+    }
+
+    // The per-frame view culling pass over a snapshot of a map-wide fight
+    static void snapshotCull(BenchSuite& suite) {
+        for (int size : SIZES) {
+            unique_ptr<Game> game = makeGame(9);
+            populate(*game, size, size, 10);
+            game->publishSnapshot(0.0f);
+            const WorldSnapshot& world = game->snapshots.acquire();
+            SDL_FRect view = {world.cameraX, world.cameraY,
+                              static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)};
+            VisibleSet visible;
+
+            suite.measure("snapshot/cull/" + to_string(size), max(1, 2000 / size),
+                [] {},
+                [&] { world.cull(view, 1.0f, visible); });
+        }
+    }
+
+    // Scripted waves: every five seconds a bigger wave spawns around the
+    // view while the autopilot fights back. The player cannot die, so every
+    // sample simulates the same number of ticks.
+    static void waves(BenchSuite& suite, const string& name, int firstWave, int waveGrowth, int ticks) {
+        unique_ptr<Game> game;
+        suite.measure(name, 1,
+            [&] {
+                game = makeGame(7);
+                game->player.maxHp = game->player.hp = 1 << 30;
+            },
+            [&] {
+                int wave = 0;
+                for (int tick = 0; tick < ticks; ++tick) {
+                    if (tick % (5 * SIMULATION_TICK_RATE) == 0) {
+                        game->spawnEnemies(firstWave + waveGrowth * wave++);
+                    }
+                    game->simulationClock.advance(TICK);
+                    game->updateHeadlessPlayer();
+                    game->update(TICK);
+                    game->player.hp = game->player.maxHp;
+                }
+            });
+    }
+
+    // Horde mode with an invulnerable player: about twelve seconds to fill up
+    // to HORDE_ENEMY_MAX tanks, then the rest of the run at full size
+    static void horde(BenchSuite& suite, int ticks) {
+        unique_ptr<Game> game;
+        suite.measure("scenario/horde", 1,
+            [&] {
+                game = makeGame(8);
+                game->hordeMode = true;
+                game->player.maxHp = game->player.hp = 1 << 30;
+            },
+            [&] {
+                for (int tick = 0; tick < ticks; ++tick) {
+                    game->simulationClock.advance(TICK);
+                    game->updateHeadlessPlayer();
+                    game->update(TICK);
+                    game->player.hp = game->player.maxHp;
+                }
+            });
+    }
+
+    static void replay(BenchSuite& suite, const string& path) {
+        Replay replay;
+        if (!replay.load(path)) {
+            return;
+        }
+
+        unique_ptr<Game> game(new Game());
+        game->setTickRate(replay.tickRate);
+        game->setSeed(replay.masterSeed);
+        game->setClock(&game->simulationClock);
+        game->headless = true;
+
+        // Name the case by file only, so results compare across checkouts in different directories
+        string name = path.substr(path.find_last_of("/\\") + 1);
+        bool matched = true;
+        suite.measure("replay/" + name, 1, [] {}, [&] {
+            for (const ReplayRun& run : replay.runs) {
+                matched = game->playReplayRun(run) && matched;
+            }
+        });
+        if (!matched) {
+            fprintf(stderr, "Replay %s no longer matches its recording; timings are not comparable\n", path.c_str());
+        }
+    }
+};
+
+namespace {
+
+void particleCases(BenchSuite& suite, SDL_Renderer* renderer) {
+    SDL_Color color = {255, 200, 0, 255};
+    ParticleSystem particles(MAX_PARTICLES);
+
+    // A busy fight: 100 bursts of muzzle flash and hit sparks
+    suite.measure("particles/emit/1500", 20,
+        [&] { particles.clear(); },
+        [&] {
+            for (int i = 0; i < 100; ++i) {
+                particles.emit(i * 20.0f, 500.0f, i * 0.1f, 15, color);
+            }
+        });
+
+    auto fill = [&] {
+        particles.clear();
+        for (int i = 0; i < 400; ++i) {
+            particles.emitCircle(i * 5.0f, 400.0f, 40.0f, 25, color, 1.0f);
+        }
+    };
+    suite.measure("particles/update/10000", 20, fill, [&] { particles.update(TICK); });
+
+    if (!renderer) {
+        return;
+    }
+    GeometryBatch batch(MAX_PARTICLES);
+    fill();
+    SDL_FRect view = {0.0f, 0.0f, static_cast<float>(MAP_WIDTH), static_cast<float>(MAP_HEIGHT)};
+    vector<int> visible;
+    particles.cull(view, visible);
+    suite.measure("particles/render/10000", 5, [] {}, [&] {
+        particles.render(batch, visible, 0.0f, 0.0f);
+        batch.flush(renderer);
+    });
+}
+
+void spriteCases(BenchSuite& suite, SDL_Renderer* renderer) {
+    SpriteBatch sprites;
+    auto queue = [&](SDL_Texture* texture, const SDL_Rect* src) {
+        // A screenful of tanks at assorted angles, as in horde mode
+        for (int i = 0; i < 1000; ++i) {
+            SDL_FRect dest = {(i % 40) * 32.0f, (i / 40) * 28.0f, 48.0f, 40.0f};
+            sprites.add(texture, src, dest, i * 0.37f);
+        }
+    };
+
+    suite.measure("sprites/add/1000", 20, [] {}, [&] {
+        queue(nullptr, nullptr);
+        sprites.clear();
+    });
+
+    SDL_Texture* sheet = renderer ? SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 256, 128)
+                                  : nullptr;
+    if (!sheet) {
+        return;
+    }
+    SDL_Rect frame = {0, 0, TANK_FRAME_WIDTH, TANK_FRAME_HEIGHT};
+    suite.measure("sprites/render/1000", 5, [] {}, [&] {
+        queue(sheet, &frame);
+        sprites.flush(renderer);
+    });
+    SDL_DestroyTexture(sheet);
+}
+
+void textCases(BenchSuite& suite, SDL_Renderer* renderer, TTF_Font* font) {
+    TextRenderer text;
+    if (!renderer || !font || !text.init(renderer, font)) {
+        printf("%-28s skipped, no font or renderer\n", "text/*");
+        return;
+    }
+
+    // What the HUD and kill feed draw in a frame
+    const string hudLines[] = {
+        "Score: 12450", "Level: 3", "HP: 340/450", "Kills: 57", "Special: 2",
+        "Health packs: 1", "KILL", "MAX HP +50", "Shield ready", "Rapid fire: 4s"
+    };
+    SDL_Color white = {255, 255, 255, 255};
+    suite.measure("text/draw/cached", 20, [] {}, [&] {
+        for (int i = 0; i < 10; ++i) {
+            text.draw(renderer, hudLines[i], 20, 20 + i * 30, white);
+        }
+    });
+
+    // Counters that change every frame miss the layout cache
+    int counter = 0;
+    suite.measure("text/draw/changing", 20, [] {}, [&] {
+        for (int i = 0; i < 10; ++i) {
+            text.draw(renderer, "Score: " + to_string(counter++), 20, 20 + i * 30, white);
+        }
+    });
+    text.destroy();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    string outputPath = "bench_results.json";
+    string label = "local";
+    vector<string> replays;
+    int threads = 0;
+    BenchSuite suite;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            suite.samples = max(3, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            label = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replays.push_back(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        } else {
+            outputPath = argv[i];
+        }
+    }
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "Unable to initialize SDL! SDL Error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    // Rendering cases draw into a window-sized surface through SDL's software
+    // renderer, so they measure our CPU-side work the same way on every machine
+    SDL_Surface* target = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_RGBA32);
+    SDL_Renderer* renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+    if (!renderer) {
+        fprintf(stderr, "Unable to create software renderer, skipping render cases! SDL Error: %s\n", SDL_GetError());
+    }
+    TTF_Font* font = nullptr;
+    if (TTF_Init() == 0) {
+        font = TTF_OpenFont("assets/fonts/VCR_OSD_MONO_1.001.ttf", 24);
+    }
+
+    JobSystem::init(threads);
+    printf("%d samples per case, %d job threads\n", suite.samples, JobSystem::threadCount());
+    GameBench::collisions(suite);
+    GameBench::enemyBehavior(suite);
+    GameBench::bulletUpdate(suite);
+    GameBench::snapshotPublish(suite);
+    GameBench::snapshotCull(suite);
+    particleCases(suite, renderer);
+    spriteCases(suite, renderer);
+    textCases(suite, renderer, font);
+    GameBench::waves(suite, "scenario/waves/small", 3, 2, 60 * SIMULATION_TICK_RATE);
+    GameBench::waves(suite, "scenario/waves/large", 20, 20, 60 * SIMULATION_TICK_RATE);
+    GameBench::horde(suite, 20 * SIMULATION_TICK_RATE);
+    for (const string& path : replays) {
+        GameBench::replay(suite, path);
+    }
+
+    bool written = suite.writeJson(outputPath, label);
+    if (written) {
+        printf("Wrote %s\n", outputPath.c_str());
+    }
+
+    if (font) {
+        TTF_CloseFont(font);
+    }
+    TTF_Quit();
+    if (renderer) {
+        SDL_DestroyRenderer(renderer);
+    }
+    if (target) {
+        SDL_FreeSurface(target);
+    }
+    JobSystem::shutdown();
+    SDL_Quit();
+    return written ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+// Microbenchmark for the recolour kernels against the per-pixel
+// SDL_GetRGBA/SDL_MapRGBA loop createRecoloredTexture used to run.
+// Usage: recolor_bench [image path] [iterations]
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "PixelOps.h"
+
+using namespace std;
+
+// Shield tint used by ResourceManager::init
+constexpr Uint8 TINT_R = 100;
+constexpr Uint8 TINT_G = 255;
+constexpr Uint8 TINT_B = 100;
+
+// The loop this replaces, kept verbatim as the reference
+static void legacyRecolor(SDL_Surface* surface, Uint8 r, Uint8 g, Uint8 b) {
+    Uint32* pixels = static_cast<Uint32*>(surface->pixels);
+    int pixelCount = surface->w * surface->h;
+    SDL_PixelFormat* format = surface->format;
+
+    for (int i = 0; i < pixelCount; ++i) {
+        Uint8 sr, sg, sb, sa;
+        SDL_GetRGBA(pixels[i], format, &sr, &sg, &sb, &sa);
+        if (sa > 0) {
+            Uint8 nr = min(255, static_cast<int>(sr * r / 255));
+            Uint8 ng = min(255, static_cast<int>(sg * g / 255));
+            Uint8 nb = min(255, static_cast<int>(sb * b / 255));
+            pixels[i] = SDL_MapRGBA(format, nr, ng, nb, sa);
+        }
+    }
+}
+
+// Same size as the 5-frame tank spritesheet, with a transparent border like the real art
+static SDL_Surface* makeSyntheticSheet() {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, 445 * 5, 115, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return nullptr;
+    }
+    Uint32 state = 12345;
+    Uint8* bytes = static_cast<Uint8*>(surface->pixels);
+    for (int i = 0; i < surface->w * surface->h * 4; ++i) {
+        state = state * 1664525u + 1013904223u;
+        bytes[i] = static_cast<Uint8>(state >> 24);
+    }
+    for (int y = 0; y < surface->h; ++y) {
+        for (int x = 0; x < surface->w; ++x) {
+            if (x % 445 < 40 || y < 10) {
+                bytes[(y * surface->w + x) * 4 + 3] = 0;
+            }
+        }
+    }
+    return surface;
+}
+
+static double elapsedMs(Uint64 start) {
+    return (SDL_GetPerformanceCounter() - start) * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+static void report(const char* name, vector<double>& samples, double baseline) {
+    sort(samples.begin(), samples.end());
+    double median = samples[samples.size() / 2];
+    printf("%-22s median %8.3f ms  best %8.3f ms  %6.1fx\n",
+           name, median, samples.front(), baseline > 0.0 ? baseline / median : 1.0);
+}
+
+int main(int argc, char* argv[]) {
+    const char* imagePath = argc > 1 ? argv[1] : nullptr;
+    int iterations = argc > 2 ? max(1, atoi(argv[2])) : 50;
+
+    if (SDL_Init(0) < 0) {
+        fprintf(stderr, "Unable to initialize SDL! SDL Error: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDL_Surface* loaded = imagePath ? IMG_Load(imagePath) : makeSyntheticSheet();
+    if (!loaded) {
+        fprintf(stderr, "Unable to load image! SDL_image Error: %s\n", IMG_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    SDL_Surface* source = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loaded);
+    if (!source) {
+        fprintf(stderr, "Unable to convert image! SDL Error: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    printf("%s: %dx%d, %d iterations\n", imagePath ? imagePath : "synthetic sheet",
+           source->w, source->h, iterations);
+
+    SDL_Surface* reference = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_Surface* work = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
+    size_t bytes = static_cast<size_t>(source->pitch) * source->h;
+    int pixelCount = source->w * source->h;
+    legacyRecolor(reference, TINT_R, TINT_G, TINT_B);
+
+    vector<double> samples;
+    for (int i = 0; i < iterations; ++i) {
+        memcpy(work->pixels, source->pixels, bytes);
+        Uint64 start = SDL_GetPerformanceCounter();
+        legacyRecolor(work, TINT_R, TINT_G, TINT_B);
+        samples.push_back(elapsedMs(start));
+    }
+    sort(samples.begin(), samples.end());
+    double baseline = samples[samples.size() / 2];
+    report("per-pixel GetRGBA", samples, baseline);
+
+    int failures = 0;
+    const PixelKernel kernels[] = {PixelKernel::SCALAR, PixelKernel::SSE2, PixelKernel::AVX2};
+    for (PixelKernel kernel : kernels) {
+        if (!pixelKernelSupported(kernel)) {
+            printf("%-22s not supported on this CPU\n", pixelKernelName(kernel));
+            continue;
+        }
+
+        samples.clear();
+        for (int i = 0; i < iterations; ++i) {
+            memcpy(work->pixels, source->pixels, bytes);
+            Uint64 start = SDL_GetPerformanceCounter();
+            tintPixelsRGBA32(static_cast<Uint32*>(work->pixels), pixelCount, TINT_R, TINT_G, TINT_B, kernel);
+            samples.push_back(elapsedMs(start));
+        }
+
+        // Every kernel must reproduce the old output bit for bit
+        if (memcmp(work->pixels, reference->pixels, bytes) != 0) {
+            printf("%-22s MISMATCH against per-pixel output\n", pixelKernelName(kernel));
+            ++failures;
+            continue;
+        }
+        report(pixelKernelName(kernel), samples, baseline);
+    }
+
+    SDL_FreeSurface(work);
+    SDL_FreeSurface(reference);
+    SDL_FreeSurface(source);
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+#ifndef ASSETIDS_H
+#define ASSETIDS_H
+
+// Every asset the game loads, listed once. Each entry expands to an enum
+// ID, its path and the load group, so code refers to assets by ID and a
+// misspelt name is a compile error rather than a nullptr at runtime.
+//   X(ID, path, LoadGroup)                  sounds and music
+//   X(ID, path, LoadGroup, TexturePacking)  textures
+
+#define TEXTURE_ASSETS(X) \
+    X(MENU_BACKGROUND, "assets/images/ui/menu_background.png", MENU, SINGLE) \
+    X(BUTTON_START, "assets/images/ui/button_start.png", MENU, ATLAS) \
+    X(BUTTON_STATS, "assets/images/ui/button_stats.png", MENU, ATLAS) \
+    X(BUTTON_TUTORIAL, "assets/images/ui/button_tutorial.png", MENU, ATLAS) \
+    X(BUTTON_SETTINGS, "assets/images/ui/button_settings.png", MENU, ATLAS) \
+    X(BUTTON_EXIT, "assets/images/ui/button_exit.png", MENU, ATLAS) \
+    X(BUTTON_START_HOVER, "assets/images/ui/button_start_hover.png", MENU, ATLAS) \
+    X(BUTTON_STATS_HOVER, "assets/images/ui/button_stats_hover.png", MENU, ATLAS) \
+    X(BUTTON_TUTORIAL_HOVER, "assets/images/ui/button_tutorial_hover.png", MENU, ATLAS) \
+    X(BUTTON_SETTINGS_HOVER, "assets/images/ui/button_settings_hover.png", MENU, ATLAS) \
+    X(BUTTON_EXIT_HOVER, "assets/images/ui/button_exit_hover.png", MENU, ATLAS) \
+    X(PLAYER_TANK, "assets/images/tank/player/tank_shoot_spritesheet.png", GAME, ATLAS) \
+    X(PLAYER_SHIELD, "assets/images/tank/player/tank_shield_spritesheet.png", GAME, ATLAS) \
+    X(ENEMY_TANK, "assets/images/tank/npc/enemy_tank.png", GAME, ATLAS) \
+    X(EXPLOSION, "assets/images/effect/explosion.png", GAME, ATLAS) \
+    X(POWERUP, "assets/images/item/powerup.png", GAME, ATLAS) \
+    X(HEALTH_PICKUP, "assets/images/item/health_pickup.png", GAME, ATLAS)
+
+#define SOUND_ASSETS(X) \
+    X(BUTTON_HOVER, "assets/sounds/button_hover.mp3", MENU) \
+    X(START_GAME, "assets/sounds/start_game.mp3", MENU) \
+    X(SHOOT, "assets/sounds/shoot.mp3", GAME) \
+    X(RAPID_FIRE, "assets/sounds/rapid_fire.mp3", GAME) \
+    X(EXPLOSION, "assets/sounds/explosion.mp3", GAME) \
+    X(POWERUP, "assets/sounds/powerup.mp3", GAME) \
+    X(SHIELD_ACTIVATE, "assets/sounds/shield_activate.mp3", GAME) \
+    X(SHIELD_DEACTIVATE, "assets/sounds/shield_deactivate.mp3", GAME) \
+    X(HEAL, "assets/sounds/heal.mp3", GAME)
+
+#define MUSIC_ASSETS(X) \
+    X(BACKGROUND, "assets/sounds/background_music.mp3", MENU)
+
+// Whether a texture shares an atlas page or gets its own texture
+enum class TexturePacking {
+    ATLAS,
+    SINGLE
+};
+
+#define ASSET_ENUM_ENTRY(id, ...) id,
+
+enum class TextureId {
+    TEXTURE_ASSETS(ASSET_ENUM_ENTRY)
+    COUNT
+};
+
+enum class SoundId {
+    SOUND_ASSETS(ASSET_ENUM_ENTRY)
+    COUNT
+};
+
+enum class MusicId {
+    MUSIC_ASSETS(ASSET_ENUM_ENTRY)
+    COUNT
+};
+
+#undef ASSET_ENUM_ENTRY
+
+constexpr int TEXTURE_COUNT = static_cast<int>(TextureId::COUNT);
+constexpr int SOUND_COUNT = static_cast<int>(SoundId::COUNT);
+constexpr int MUSIC_COUNT = static_cast<int>(MusicId::COUNT);
+
+#endif // !ASSETIDS_H
@@ -0,0 +1,60 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <SDL.h>
+#include <string>
+#include <unordered_map>
+
+using namespace std;
+
+// On-disk layout of assets.pack, written by tools/AssetPacker:
+//   AssetPackHeader | entry data (16-byte aligned) | AssetPackEntry[entryCount]
+// All fields are little-endian. Entry names are the original asset paths.
+constexpr char ASSET_PACK_MAGIC[4] = {'T', 'P', 'A', 'K'};
+constexpr Uint32 ASSET_PACK_VERSION = 1;
+constexpr int ASSET_PACK_NAME_LENGTH = 96;
+
+enum AssetPackEntryType : Uint32 {
+    PACK_TEXTURE_RGBA32 = 1, // Tightly packed SDL_PIXELFORMAT_RGBA32 rows; param0 = width, param1 = height
+    PACK_AUDIO_PCM = 2,      // Samples in the mixer's format; param0 = frequency, param1 = format, param2 = channels
+    PACK_RAW_FILE = 3        // Original file bytes (music streams, fonts)
+};
+
+struct AssetPackHeader {
+    char magic[4];
+    Uint32 version;
+    Uint32 entryCount;
+    Uint32 tocOffset;
+};
+
+struct AssetPackEntry {
+    char name[ASSET_PACK_NAME_LENGTH];
+    Uint32 type;
+    Uint32 offset;
+    Uint32 size;
+    Uint32 param0, param1, param2;
+};
+
+// Read-only, memory-mapped view of an asset pack. Entry data can be handed
+// to SDL directly; it stays valid until close().
+class AssetPack {
+private:
+    const Uint8* base;
+    size_t mappedSize;
+    void* fileHandle;    // Windows file and mapping handles
+    void* mappingHandle;
+    unordered_map<string, const AssetPackEntry*> entries;
+
+public:
+    AssetPack();
+    ~AssetPack();
+
+    bool open(const string& path);
+    void close();
+    bool isOpen() const;
+
+    const AssetPackEntry* find(const string& name) const;
+    const void* data(const AssetPackEntry& entry) const;
+};
+
+#endif // !ASSETPACK_H
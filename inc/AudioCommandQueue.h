@@ -0,0 +1,45 @@
+#ifndef AUDIOCOMMANDQUEUE_H
+#define AUDIOCOMMANDQUEUE_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+// One change to the mixer's channels, applied on the audio thread
+struct AudioCommand {
+    enum Type {
+        PLAY,   // Start chunk on channel, cutting off whatever was there
+        VOLUME  // Set channel's volume (0-128), or every channel's for -1
+    };
+
+    Type type;
+    int channel;
+    Mix_Chunk* chunk;
+    int volume;
+};
+
+// Fixed-size single-producer, single-consumer ring. One thread pushes, one
+// other thread drains; neither ever takes a lock or waits for the other.
+// Each index is only ever stored by its own side, so publishing it is the
+// only synchronisation needed.
+class AudioCommandQueue {
+public:
+    static constexpr int CAPACITY = 256; // Power of two, so indices wrap with a mask
+
+private:
+    AudioCommand commands[CAPACITY];
+    SDL_atomic_t writeIndex; // Commands pushed so far; stored by the producer only
+    SDL_atomic_t readIndex;  // Commands drained so far; stored by the consumer only
+
+public:
+    AudioCommandQueue();
+
+    // Producer side; returns false, leaving the queue as it was, if it is full
+    bool push(const AudioCommand& command);
+    // Consumer side; calls apply on every command pushed so far, oldest first
+    void drain(void (*apply)(const AudioCommand& command));
+    // Producer side; drops anything not yet drained. Only safe while the
+    // consumer is stopped.
+    void clear();
+};
+
+#endif // !AUDIOCOMMANDQUEUE_H
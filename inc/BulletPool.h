@@ -0,0 +1,60 @@
+#ifndef BULLETPOOL_H
+#define BULLETPOOL_H
+
+#include <SDL.h>
+#include <vector>
+
+#include "Constants.h"
+#include "Structures.h"
+#include "GeometryBatch.h"
+
+using namespace std;
+
+// Per-bullet flag bits
+enum BulletFlag : Uint8 {
+    BULLET_ACTIVE = 1 << 0,
+    BULLET_FROM_ENEMY = 1 << 1,
+    BULLET_SPECIAL = 1 << 2
+};
+
+// Fixed-capacity bullet storage laid out as parallel arrays. Live bullets
+// are packed into [0, size()), so the free slots are simply the tail:
+// spawning writes at size() and compact() swap-and-pops dead bullets.
+// Nothing is allocated after construction.
+class BulletPool {
+public:
+    vector<float> x, y, vx, vy;
+    vector<float> prevX, prevY; // Position at the start of the current tick, for interpolation
+    vector<int> damage;
+    vector<Uint8> flags;
+
+private:
+    int capacity;
+    int count;
+
+public:
+    BulletPool(int capacity_ = MAX_BULLETS);
+
+    int size() const;
+    // Returns the new bullet's index, or -1 when the pool is full
+    int spawn(float x_, float y_, float vx_, float vy_, bool enemy, int damage_ = 10, bool special = false);
+    bool isActive(int i) const;
+    bool isFromEnemy(int i) const;
+    bool isSpecial(int i) const;
+    // Marks a bullet dead; its slot is reclaimed by the next compact()
+    void kill(int i);
+    void clear();
+
+    // Advances every bullet and culls those past BORDER_OFFSET in one pass
+    void update(float deltaTime);
+    void storePreviousState();
+    void compact();
+    // Copies just the live bullets' drawn fields, for a render snapshot
+    void copyForRender(const BulletPool& source);
+    // Collects the active bullets overlapping the view; returns how many were left out
+    int cull(const SDL_FRect& view, float alpha, vector<int>& visible) const;
+    // Queues the bullets listed by cull(); the caller flushes the batch
+    void render(GeometryBatch& batch, const vector<int>& visible, float cameraX, float cameraY, float alpha = 1.0f);
+};
+
+#endif // !BULLETPOOL_H
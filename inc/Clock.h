@@ -0,0 +1,33 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <SDL.h>
+
+// Source of game time in milliseconds. The simulation reads time through a
+// Clock instead of SDL_GetTicks() so it can be stepped without a window.
+class Clock {
+public:
+    virtual ~Clock() = default;
+
+    virtual Uint32 now() const = 0;
+};
+
+// Wall-clock time, backed by SDL_GetTicks()
+class SystemClock : public Clock {
+public:
+    Uint32 now() const override;
+};
+
+// Time that only moves when the owner advances it (headless runs)
+class ManualClock : public Clock {
+private:
+    double time; // Milliseconds, kept fractional so small steps accumulate
+
+public:
+    ManualClock(Uint32 start = 0);
+
+    Uint32 now() const override;
+    void advance(float seconds);
+};
+
+#endif // !CLOCK_H
@@ -0,0 +1,38 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <SDL.h>
+#include <vector>
+
+#include "BulletPool.h"
+#include "ParticleSystem.h"
+
+using namespace std;
+
+// Bullet spawns and particle bursts recorded by a job instead of applied on
+// the spot, so parallel passes never touch the shared pools. apply() replays
+// them in recording order on the calling thread.
+class CommandBuffer {
+public:
+    struct BulletSpawn {
+        float x, y, vx, vy;
+        bool enemy;
+        int damage;
+    };
+
+    struct ParticleBurst {
+        float x, y, angle;
+        int count;
+        SDL_Color color;
+    };
+
+    vector<BulletSpawn> bulletSpawns;
+    vector<ParticleBurst> particleBursts;
+
+    void clear();
+    void spawnBullet(float x, float y, float vx, float vy, bool enemy, int damage);
+    void emitParticles(float x, float y, float angle, int count, SDL_Color color);
+    void apply(BulletPool& bullets, ParticleSystem& particles) const;
+};
+
+#endif // !COMMANDBUFFER_H
@@ -9,16 +9,32 @@ constexpr int WINDOW_HEIGHT = 750;
 constexpr int MAP_WIDTH = 2000;
 constexpr int MAP_HEIGHT = 1600;
 constexpr float BULLET_SPEED = 10.0f;
+constexpr int MAX_BULLETS = 4096;            // Capacity of the preallocated bullet pool
+constexpr int MAX_PARTICLES = 20000;         // Capacity of the particle pool
+constexpr int MAX_ENEMIES = 4096;            // Capacity of the enemy pool
 constexpr float RECOIL_FORCE = 10.0f;
 constexpr float BOUNCE_FACTOR = 0.9f;
 constexpr int BORDER_OFFSET = 200;
 constexpr int ENEMY_SPAWN_INTERVAL = 2000;
 constexpr int ENEMY_COUNT_MAX = 5; // Increased max enemies
+constexpr int HORDE_ENEMY_MAX = 2500;        // Horde mode (--horde): enemy cap
+constexpr int HORDE_SPAWN_INTERVAL = 200;    // Horde mode: ms between waves
+constexpr int HORDE_SPAWN_BATCH = 40;        // Horde mode: tanks per wave
+constexpr int ENEMY_JOB_BATCH = 128;         // Enemies per job in the parallel AI pass
 constexpr float ENEMY_SPEED = 1.0f;
 constexpr Uint32 ENEMY_SHOOT_DELAY = 3500;
 constexpr float TANK_COLLISION_FORCE = 1.5f;
 constexpr int EXPLOSION_DURATION = 500;
 constexpr int EXPLOSION_RADIUS = 30;
+constexpr float COLLISION_CELL_SIZE = 70.0f; // Broad-phase cell, twice the largest tank collisionRadius
+
+// Simulation timing constants
+constexpr int SIMULATION_TICK_RATE = 60;     // Default fixed simulation steps per second
+constexpr float MAX_FRAME_TIME = 0.25f;      // Longest frame fed to the accumulator (spiral-of-death clamp)
+constexpr Uint32 LOADING_UPLOAD_BUDGET_MS = 4; // Texture upload time per frame while assets stream in
+constexpr int ATLAS_PAGE_SIZE = 4096;         // Largest atlas page side, if the renderer allows it
+constexpr int AUDIO_VOICES = 16;              // Mixer channels the voice manager deals out
+constexpr int AUDIO_BUFFER_SAMPLES = 512;     // Mixer buffer, about 12 ms at 44.1 kHz
 
 // Minimap constants
 constexpr int MINIMAP_WIDTH = 200;
@@ -0,0 +1,78 @@
+#ifndef ENEMYPOOL_H
+#define ENEMYPOOL_H
+
+#include <SDL.h>
+#include <vector>
+
+#include "Constants.h"
+#include "Structures.h"
+#include "GeometryBatch.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+
+using namespace std;
+
+// Fixed-capacity enemy tank storage laid out as parallel arrays, like
+// BulletPool. The fields every tick reads sit in their own arrays, apart
+// from the per-type stats and the sizes only rendering needs, so AI and
+// collision passes over thousands of tanks stay in cache. Live enemies are
+// packed into [0, size()); compact() removes dead ones in order, so the
+// update order (and with it the random draws) matches spawn order.
+class EnemyPool {
+public:
+    // Hot: read or written by every simulation pass
+    vector<float> x, y, vx, vy, angle;
+    vector<float> radius;
+    vector<int> hp;
+    vector<Uint8> alive;
+    vector<float> prevX, prevY, prevAngle; // State at the start of the current tick, for interpolation
+
+    // Per-type stats and timers, read by AI and firing
+    vector<EnemyType> type;
+    vector<float> speed;
+    vector<int> damage;
+    vector<Uint32> lastShotTime;
+
+    // Cold: only drawing reads these
+    vector<int> width, height;
+    vector<int> maxHp;
+
+private:
+    int capacity;
+    int count;
+
+public:
+    EnemyPool(int capacity_ = MAX_ENEMIES);
+
+    int size() const;
+    // Returns the new enemy's index, or -1 when the pool is full
+    int spawn(float x_, float y_, EnemyType type_);
+    bool isAlive(int i) const;
+    // Marks an enemy dead; its slot is reclaimed by the next compact()
+    void kill(int i);
+    void clear();
+
+    // Integrates velocity, clamps speed and applies friction for enemies [begin, end)
+    void update(float deltaTime, int begin, int end);
+    void update(float deltaTime);
+    void storePreviousState();
+    void compact();
+    // Copies just the live enemies' drawn fields, for a render snapshot
+    void copyForRender(const EnemyPool& source);
+
+    // Position and angle blended between the previous and current tick
+    float renderX(int i, float alpha) const;
+    float renderY(int i, float alpha) const;
+    float renderAngle(int i, float alpha) const;
+    // Collects the live enemies whose sprite or health bar overlaps the view;
+    // returns how many were left out
+    int cull(const SDL_FRect& view, float alpha, vector<int>& visible) const;
+    // Queues the enemies listed by cull(); the caller flushes the batch
+    void render(SpriteBatch& batch, TextureHandle texture, const vector<int>& visible,
+                float cameraX, float cameraY, float alpha);
+    // Queues health bars for the enemies listed by cull(); the caller flushes the batch
+    void renderHealthBars(GeometryBatch& batch, const vector<int>& visible,
+                          float cameraX, float cameraY, float alpha);
+};
+
+#endif // !ENEMYPOOL_H
@@ -3,17 +3,24 @@
 
 #include <SDL.h>
 
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
+
 class Explosion {
 public:
     float x, y;
     Uint32 startTime;
+    float progress; // 0 at spawn, 1 when finished
     bool active;
-    SDL_Texture* texture;
+    TextureHandle texture;
     bool isSpecial;
 
-    Explosion(float x_, float y_, bool special = false);
+    Explosion(float x_, float y_, Uint32 currentTime, bool special = false);
 
-    void render(SDL_Renderer* renderer, float cameraX, float cameraY);
+    // Advances the animation and deactivates the explosion once it has finished
+    void update(Uint32 currentTime);
+    // Queues the fading sprite; renderer is only needed for the fallback disc
+    void render(SpriteBatch& batch, SDL_Renderer* renderer, float cameraX, float cameraY);
 };
 
 #endif // !EXPLOSION_H
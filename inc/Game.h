@@ -8,13 +8,26 @@
 
 #include "Structures.h"
 #include "Constants.h"
+#include "Clock.h"
 #include "ResourceManager.h"
 #include "Tank.h"
-#include "Bullet.h"
+#include "EnemyPool.h"
+#include "BulletPool.h"
 #include "Explosion.h"
 #include "PowerUp.h"
 #include "ParticleSystem.h"
 #include "KillNotification.h"
+#include "SpatialGrid.h"
+#include "TextRenderer.h"
+#include "HudLayer.h"
+#include "SpriteBatch.h"
+#include "Random.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "CommandBuffer.h"
+#include "JobSystem.h"
+#include "WorldSnapshot.h"
+#include "VoiceManager.h"
 
 using namespace std;
 
@@ -23,28 +36,45 @@ private:
     GameState state;
     SDL_Renderer* renderer;
     TTF_Font* font;
-    Mix_Music* backgroundMusic;
-    Mix_Chunk* shootSound;
-    Mix_Chunk* rapidFireSound;
-    Mix_Chunk* explosionSound;
-    Mix_Chunk* powerupSound;
-    Mix_Chunk* shieldActivateSound;   // New sound for shield activation
-    Mix_Chunk* shieldDeactivateSound; // New sound for shield deactivation
-    Mix_Chunk* healSound;             // New sound for healing
-    Mix_Chunk* buttonHoverSound;      // New: Sound for button hover
-    Mix_Chunk* startGameSound = nullptr;
-    SDL_Texture* playerTexture;
-    SDL_Texture* playerShieldTexture; // New texture for shield animation
-    SDL_Texture* enemyTexture;
+    TextRenderer textRenderer; // Glyph atlas for every string drawn on screen
+    HudLayer hud;
+    HudWidgets hudWidgets;
+    // Handles resolve once the background loader has published the asset
+    MusicHandle backgroundMusic;
+    SoundHandle shootSound;
+    SoundHandle rapidFireSound;
+    SoundHandle explosionSound;
+    SoundHandle powerupSound;
+    SoundHandle shieldActivateSound;   // New sound for shield activation
+    SoundHandle shieldDeactivateSound; // New sound for shield deactivation
+    SoundHandle healSound;             // New sound for healing
+    SoundHandle buttonHoverSound;      // New: Sound for button hover
+    SoundHandle startGameSound;
+    TextureHandle playerTexture;
+    TextureHandle playerShieldTexture; // New texture for shield animation
+    TextureHandle enemyTexture;
+    bool assetsLoaded = false;
+    bool startAfterLoading = false;    // Start was clicked before the game assets were ready
     Tank player;
-    vector<Tank> enemies;
-    vector<Bullet> bullets;
+    EnemyPool enemies;
+    BulletPool bullets;
     vector<Explosion> explosions;
     vector<PowerUp> powerups;
     vector<KillNotification> killNotifications;
     ParticleSystem particles;
+    GeometryBatch geometry;    // Bullet and particle quads, submitted once per frame
+    SpriteBatch sprites;       // Tank, power-up and explosion sprites, one call per texture
+    VisibleSet visible;        // What renderGame draws this frame, see WorldSnapshot::cull
+    SpatialGrid enemyGrid;     // Broad phase over enemies, rebuilt each tick
+    SpatialGrid powerUpGrid;   // Broad phase over power-ups for pickup tests
+    vector<int> nearbyItems;   // Scratch buffers for grid queries
+    vector<int> neighbourItems;
+    vector<SteerJitter> steerJitter;     // Per enemy, see drawSteerJitter()
+    vector<CommandBuffer> enemyCommands; // Side effects of each AI batch, applied in batch order
     float cameraX, cameraY;
+    float prevCameraX, prevCameraY; // Camera at the start of the current tick
     bool rightMouseHeld;
+    bool keyAHeld = false;     // Cancels a charging special shot
     float normalCameraZoom;
     float currentCameraZoom;
 
@@ -59,8 +89,40 @@ private:
     int difficulty;
     float gameTime;
 
+    // Time source for the simulation; points at systemClock unless replaced
+    SystemClock systemClock;
+    ManualClock simulationClock; // Advanced by exactly one tick per fixed step
+    Clock* clock;
+    int tickRate = SIMULATION_TICK_RATE;
+    int audioBufferSamples = AUDIO_BUFFER_SAMPLES;
+    float renderAlpha = 1.0f;   // Fraction of a tick elapsed since the last step
+
+    // Windowed runs step the simulation on a thread of its own (see runSimulation);
+    // it holds simulationMutex through each batch of ticks, event handling holds it too
+    SDL_Thread* simulationThread = nullptr;
+    SDL_mutex* simulationMutex = nullptr;
+    SDL_atomic_t simulationQuit;
+    SnapshotBuffer snapshots;   // Ticked worlds on their way to render()
+
+    RandomService random;       // All gameplay randomness, from one master seed
+    int lastSpawnEdge = -1;
+    float basicSteerTime = 0.0f; // Basic-tank steering, in 1/60 s steps, since the last heading change
+    bool headless = false;
+    bool hordeMode = false;     // Thousands of enemies, for stress testing
+    int spawnBatchStart = 0;    // First enemy spawned by the current spawnEnemies() call
+    bool profileHeadless = false;
+    Uint32 lastHeadlessShotTime = 0;
+
+    // Input recorded per tick; see Replay.h
+    vector<InputEvent> pendingInput; // Applied at the start of the next tick
+    Uint32 runTick = 0;         // Ticks since reset()
+    Uint32 nextRunIndex = 0;    // Random streams for the next reset()
+    Replay recording;
+    string recordPath;          // Empty unless --record was given
+    bool recordingRun = false;
+
     // Menu properties
-    SDL_Texture* menuBackgroundTexture;
+    TextureHandle menuBackgroundTexture;
     vector<MenuButtonInfo> menuButtons;
     MenuButton currentHoveredButton;
     Stats stats;
@@ -99,23 +161,53 @@ private:
     bool hoverGameOverMenu = false;
     bool prevHoverGameOverMenu = false;
 
+    friend class GameBench; // bench/GameBench.cpp drives the private hot paths directly
+
 public:
     Game();
     ~Game();
 
     int run();
+    // Step the simulation without a window, renderer or audio device
+    int runHeadless(int frames);
+    void setClock(Clock* c);
+    void setTickRate(int hz);
+    // Mixer buffer size, rounded up to a power of two between 128 and 4096
+    void setAudioBufferSamples(int samples);
+    void setSeed(Uint64 seed);
+    // Collect profiler timings from the start; headless runs print a summary
+    void setProfiling(bool enable);
+    // Spawn waves of up to HORDE_ENEMY_MAX enemies instead of a handful
+    void setHordeMode(bool enable);
+    // Write every run's input to path as it finishes
+    void setRecordPath(const string& path);
+    // Play a recorded session headless; returns 1 if any run diverges
+    int runReplay(const string& path);
 
 private:
     void init(SDL_Renderer* rend, TTF_Font* f);
     void handleEvents(SDL_Event& e, bool& quit);
     void update(float deltaTime);
-    void render();
+    void storePreviousState();
+    static int simulationMain(void* data);
+    void runSimulation();
+    // Copies what drawing needs into the next snapshot and hands it over
+    void publishSnapshot(float alpha);
+    void render(GameState frameState);
 
+    void updateHeadlessPlayer();
     void handleSpecialAbility(float deltaTime);
-    void renderSpecialTargetingLine();
+    void renderSpecialTargetingLine(const Tank& tank, float viewX, float viewY);
     void handleMenuEvents(SDL_Event& e);
     void handlePauseEvents(SDL_Event& e);
     void handleGameEvents(SDL_Event& e);
+    void queueInput(const InputEvent& input);
+    void applyInputs();
+    void applyInput(const InputEvent& input);
+    void finishRun();
+    // Resets and steps one recorded run; true if it ends in the recorded state
+    bool playReplayRun(const ReplayRun& run);
+    Uint32 stateChecksum() const;
     void handleTutorialEvents(SDL_Event& e);
     void handleSettingsEvents(SDL_Event& e);
     void handleStatsEvents(SDL_Event& e);
@@ -125,30 +217,41 @@ private:
     bool isMouseInsideBorder(int mouseX, int mouseY);
     void updateCamera();
     void updateDifficulty();
+    bool bounceOffWalls(float& x, float& y, float& vx, float& vy, float radius);
     void handleWallBounce(Tank& tank);
+    void handleEnemyWallBounce(int enemy, CommandBuffer& commands);
     void shoot();
     void handleRapidFire(float deltaTime);
+    void spawnEnemies(int count);
     void spawnEnemy();
     void spawnPowerUp();
     void spawnHealthPickup();
-    void updateEnemyBehavior(Tank& enemy, float deltaTime);
-    void enemyShoot(Tank& enemy);
+    // AI, wall bounces, firing and movement for every enemy, as jobs
+    void updateEnemies(float deltaTime);
+    void drawSteerJitter(float deltaTime);
+    void updateEnemyBehavior(int enemy, float deltaTime);
+    void enemyShoot(int enemy, CommandBuffer& commands);
+    void rebuildEnemyGrid();
     void handleCollisions();
     void applyPowerUp(const PowerUp& powerup);
     void cleanup();
     void reset();
-    void renderGame();
+    // Everything drawn in world space, timed as the WORLD zone
+    void renderWorld(WorldSnapshot& world);
+    void renderGame(WorldSnapshot& world);
     void updateHealthRegenInfo(float deltaTime);
-    void renderHealthRegenInfo();
-    void renderCooldowns();
-    void renderCooldownBar(int x, int y, int width, int height, float percentage, SDL_Color color);
+    void renderHealthRegenInfo(const HealthRegenInfo& regen);
+    void updateHudCooldowns(const WorldSnapshot& world);
     void renderText(const string& text, int x, int y, SDL_Color color);
     void renderMenu();
     void renderPauseMenu();
-    void renderGameOver();
-    void renderStats();
-    void renderMinimap();
+    void renderGameOver(const WorldSnapshot& world);
+    void initializeHud();
+    void updateHud(const WorldSnapshot& world);
+    void renderMinimap(const WorldSnapshot& world);
     void initializeMenu();
+    void updateLoading();
+    void renderLoadingScreen();
     void updateButtonAnimations();
     void renderPauseScreen();
     void renderTutorialScreen();
@@ -0,0 +1,28 @@
+#ifndef GEOMETRYBATCH_H
+#define GEOMETRYBATCH_H
+
+#include <SDL.h>
+#include <vector>
+
+using namespace std;
+
+// Collects untextured, per-vertex coloured quads and submits them all in a
+// single SDL_RenderGeometry call. The index buffer only ever grows, since
+// quad i always uses vertices 4i..4i+3.
+class GeometryBatch {
+private:
+    vector<SDL_Vertex> vertices;
+    vector<int> indices;
+    size_t quadCount;
+
+public:
+    GeometryBatch(size_t reserveQuads = 1024);
+
+    void addRect(float x, float y, float w, float h, SDL_Color color);
+    size_t size() const;
+    void clear();
+    // Draws every queued quad with alpha blending, then empties the batch
+    void flush(SDL_Renderer* renderer);
+};
+
+#endif // !GEOMETRYBATCH_H
@@ -0,0 +1,64 @@
+#ifndef HUDLAYER_H
+#define HUDLAYER_H
+
+#include <SDL.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "TextRenderer.h"
+
+using namespace std;
+
+enum class HudWidgetType {
+    LABEL, // Text with at most one %d, replaced by the widget value; no other printf codes
+    BAR,   // Progress bar; the value is the filled width in pixels
+    PANEL  // Static drawing, repainted only when invalidated
+};
+
+// Retained-mode HUD: every widget owns a render-target texture that is
+// repainted only when its bound value changes, so a frame costs one
+// SDL_RenderCopy per visible widget.
+class HudLayer {
+private:
+    struct HudWidget {
+        HudWidgetType type;
+        SDL_Rect rect;         // Screen position and current content size
+        SDL_Color color;
+        string prefix, suffix; // Label text either side of its %d
+        bool showsValue;       // Whether the label had a %d at all
+        function<void(SDL_Renderer*, int, int)> painter; // Panels only, draws at the given origin
+        SDL_Texture* texture;
+        int textureWidth, textureHeight;
+        int value;
+        bool visible;
+        bool dirty;
+    };
+
+    vector<HudWidget> widgets;
+    bool targetsSupported;
+    char textBuffer[128];
+
+    const char* formatLabel(const HudWidget& widget);
+    void paint(SDL_Renderer* renderer, TextRenderer& textRenderer, HudWidget& widget, int originX, int originY);
+    bool prepareTexture(SDL_Renderer* renderer, HudWidget& widget);
+
+public:
+    HudLayer();
+    ~HudLayer();
+
+    int addLabel(int x, int y, const string& format, SDL_Color color, int value = 0);
+    int addBar(int x, int y, int width, int height, SDL_Color color);
+    int addPanel(int x, int y, int width, int height, function<void(SDL_Renderer*, int, int)> painter);
+
+    void setValue(int id, int value);
+    void setBarFill(int id, float percentage);
+    void setVisible(int id, bool visible);
+
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer);
+    // Forces every widget to be repainted, e.g. after SDL_RENDER_TARGETS_RESET
+    void invalidate();
+    void destroy();
+};
+
+#endif // !HUDLAYER_H
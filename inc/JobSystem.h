@@ -0,0 +1,59 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <SDL.h>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+// Body of a parallel loop: handles items [begin, end), which form batch number batch
+typedef function<void(int begin, int end, int batch)> BatchJob;
+
+// Thread pool for data-parallel simulation passes. parallelFor cuts a range
+// into fixed-size batches and deals them out as one contiguous run per
+// thread; a thread that finishes its run steals batches from the far end of
+// another's. The calling thread takes a run too and returns once every batch
+// is done. Batch boundaries depend only on the item count and batch size,
+// never on the thread count, so results kept per batch can be merged in
+// batch order to get the same outcome on any machine. Until init() is
+// called (or with one thread) batches run inline, in order.
+class JobSystem {
+private:
+    // Batches still owned by one thread: the owner takes from next, thieves from end
+    struct BatchRange {
+        SDL_SpinLock lock;
+        int next;
+        int end;
+    };
+
+    static vector<SDL_Thread*> workers;
+    static vector<BatchRange> ranges; // One per worker, then the calling thread's
+    static SDL_mutex* mutex;
+    static SDL_cond* wakeCond;
+    static SDL_cond* doneCond;
+    static Uint32 generation;         // Bumped by every parallelFor that wakes the workers
+    static int busyWorkers;           // Workers not yet out of batches in the current loop
+    static bool quitting;
+
+    // The loop being run; only written while every worker is asleep
+    static const BatchJob* currentJob;
+    static int currentCount;
+    static int currentBatchSize;
+
+    static int workerMain(void* data);
+    static bool takeBatch(int self, int& batch);
+    static void runBatches(int self);
+
+public:
+    // threads counts the calling thread; 0 starts one thread per CPU core
+    static void init(int threads = 0);
+    static void shutdown();
+    static int threadCount();
+    static int batchCount(int count, int batchSize);
+    // Runs job over [0, count) in batches of batchSize and waits for all of them.
+    // Not reentrant: jobs must not call parallelFor themselves
+    static void parallelFor(int count, int batchSize, const BatchJob& job);
+};
+
+#endif // !JOBSYSTEM_H
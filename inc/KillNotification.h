@@ -2,10 +2,10 @@
 #define KILLNOTIFICATION_H
 
 #include <SDL.h>
-#include <SDL_ttf.h>
 #include <string>
 
 #include "ResourceManager.h"
+#include "TextRenderer.h"
 
 using namespace std;
 
@@ -15,10 +15,10 @@ public:
     Uint32 startTime;
     bool active;
 
-    KillNotification(const string& text_);
+    KillNotification(const string& text_, Uint32 currentTime);
 
-    bool update();
-    void render(SDL_Renderer* renderer, TTF_Font* font);
+    bool update(Uint32 currentTime);
+    void render(SDL_Renderer* renderer, TextRenderer& textRenderer, Uint32 currentTime);
 };
 
 #endif // !KILLNOTIFICATION_H
@@ -5,21 +5,47 @@
 #include <vector>
 
 #include "Structures.h"
+#include "Random.h"
+#include "GeometryBatch.h"
 
 using namespace std;
 
 class ParticleSystem {
 private:
+    // Live particles are packed into [0, liveCount); a dying particle is
+    // replaced by the last live one, so the free slots are always the tail.
     vector<Particle> particles;
+    size_t liveCount;
+    size_t recycleCursor;
+    ParticleOverflow overflowPolicy;
+    ParticlePoolStats stats;
+    Rng ownRng;
+    Rng* rng; // Defaults to ownRng; the game points it at its VFX stream
+
+    // Returns a slot for one new particle, or nullptr if it must be dropped
+    Particle* allocate(bool& saturated);
 
 public:
-    ParticleSystem(int maxParticles = 1000);
+    ParticleSystem(int maxParticles = 1000, ParticleOverflow policy = ParticleOverflow::DROP);
 
-    void emit(float x, float y, float angle, int count, SDL_Color color, int life = 30);
+    // Life is the longest lifetime in seconds; each particle gets half to all of it
+    void emit(float x, float y, float angle, int count, SDL_Color color, float life = 0.5f);
     // New method to emit particles in a circle (for shield effect)
-    void emitCircle(float x, float y, float radius, int count, SDL_Color color, int life = 30);
-    void update();
-    void render(SDL_Renderer* renderer, float cameraX, float cameraY);
+    void emitCircle(float x, float y, float radius, int count, SDL_Color color, float life = 0.5f);
+    void update(float deltaTime);
+    // Collects the live particles overlapping the view; returns how many were left out
+    int cull(const SDL_FRect& view, vector<int>& visible) const;
+    // Queues the particles listed by cull(); the caller flushes the batch
+    void render(GeometryBatch& batch, const vector<int>& visible, float cameraX, float cameraY);
+    void clear();
+    // Copies just the live particles, for a render snapshot
+    void copyForRender(const ParticleSystem& source);
+
+    void setRng(Rng* rng_);
+    void setOverflowPolicy(ParticleOverflow policy);
+    size_t liveParticles() const;
+    size_t capacity() const;
+    const ParticlePoolStats& getStats() const;
 };
 
 #endif // !PARTICLESYSTEM_H
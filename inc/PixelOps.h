@@ -0,0 +1,24 @@
+#ifndef PIXELOPS_H
+#define PIXELOPS_H
+
+#include <SDL.h>
+
+// Implementations of the pixel kernels; AUTO picks the widest the CPU supports
+enum class PixelKernel {
+    AUTO,
+    SCALAR,
+    SSE2,
+    AVX2
+};
+
+// Multiplies the colour of every pixel with non-zero alpha by (r, g, b) / 255,
+// rounding down, and leaves alpha untouched. Pixels must be SDL_PIXELFORMAT_RGBA32.
+// Safe to call from any thread.
+void tintPixelsRGBA32(Uint32* pixels, int count, Uint8 r, Uint8 g, Uint8 b,
+                      PixelKernel kernel = PixelKernel::AUTO);
+
+// Whether the kernel was compiled in and the CPU can run it
+bool pixelKernelSupported(PixelKernel kernel);
+const char* pixelKernelName(PixelKernel kernel);
+
+#endif // !PIXELOPS_H
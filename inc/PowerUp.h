@@ -4,6 +4,8 @@
 #include <SDL.h>
 
 #include "Structures.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
 
 class PowerUp {
 public:
@@ -11,11 +13,12 @@ public:
     bool active;
     PowerUpType type;
     Uint32 spawnTime;
-    SDL_Texture* texture;
+    TextureHandle texture;
 
-    PowerUp(float x_, float y_, PowerUpType type_);
+    PowerUp(float x_, float y_, PowerUpType type_, Uint32 currentTime);
 
-    void render(SDL_Renderer* renderer, float cameraX, float cameraY);
+    // Queues the pulsing sprite; the caller flushes the batch
+    void render(SpriteBatch& batch, float cameraX, float cameraY, Uint32 currentTime);
 };
 
 #endif // !POWERUP_H
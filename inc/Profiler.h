@@ -0,0 +1,153 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class TextRenderer;
+
+// Parts of a frame the profiler times. Zones may nest; each one's time
+// includes the zones inside it.
+enum class ProfileZone {
+    FRAME,
+    EVENTS,
+    LOADING,
+    UPDATE,
+    PLAYER,
+    AI,
+    BULLETS,
+    PARTICLES,
+    COLLISIONS,
+    CLEANUP,
+    RENDER,
+    WORLD,
+    HUD,
+    MINIMAP,
+    PRESENT,
+    COUNT
+};
+
+// Per-frame object counts shown under the zone timings
+enum class ProfileCounter {
+    ENEMIES_DRAWN,
+    ENEMIES_CULLED,
+    BULLETS_DRAWN,
+    BULLETS_CULLED,
+    PARTICLES_DRAWN,
+    PARTICLES_CULLED,
+    POWERUPS_DRAWN,
+    POWERUPS_CULLED,
+    EXPLOSIONS_DRAWN,
+    EXPLOSIONS_CULLED,
+    COUNT
+};
+
+constexpr int PROFILE_ZONE_COUNT = static_cast<int>(ProfileZone::COUNT);
+constexpr int PROFILE_COUNTER_COUNT = static_cast<int>(ProfileCounter::COUNT);
+constexpr int PROFILER_HISTORY_FRAMES = 240;   // Window for the averages and percentiles
+constexpr int PROFILER_CAPTURE_FRAMES = 120;   // Frames written to one trace file
+
+// Rolling timings for one zone, in milliseconds per frame
+struct ProfileZoneStats {
+    double average;
+    double p95;
+    double p99;
+    int calls; // Per frame, averaged
+};
+
+// Frame profiler. ProfileScope timers on any thread add into the current
+// frame, which the main thread opens and closes, so simulation ticks count
+// towards the frame they ran during. Finished frames go into a ring buffer
+// that feeds the F3 overlay, and F4 captures the next frames as a Chrome
+// trace (chrome://tracing or ui.perfetto.dev), one track per thread. While
+// neither is active a scope costs an atomic load and a branch.
+class Profiler {
+private:
+    struct FrameRecord {
+        Uint64 ticks[PROFILE_ZONE_COUNT];
+        int calls[PROFILE_ZONE_COUNT];
+        int counters[PROFILE_COUNTER_COUNT];
+    };
+
+    struct TraceEvent {
+        ProfileZone zone;
+        Uint64 start, end;
+        SDL_threadID thread;
+    };
+
+    static SDL_SpinLock lock;   // Guards the current frame and trace events against other threads' scopes
+    static SDL_atomic_t enabled; // Collecting at all: overlay, capture or forced on; read on every thread
+    static bool forcedOn;
+    static bool overlayVisible;
+    static Uint64 frameStart;
+    static FrameRecord current;
+    static vector<FrameRecord> history; // Ring buffer of finished frames
+    static int historyNext;
+    static int historyCount;
+
+    static bool capturing;
+    static int captureFramesLeft;
+    static Uint64 captureStart;
+    static vector<TraceEvent> traceEvents;
+    static string capturePath;
+
+    static ProfileZoneStats cachedStats[PROFILE_ZONE_COUNT];
+    static double cachedCounters[PROFILE_COUNTER_COUNT];
+    static Uint64 lastStatsUpdate;
+
+    static void updateEnabled();
+    static void record(ProfileZone zone, Uint64 start, Uint64 end);
+
+    friend class ProfileScope;
+
+public:
+    static const char* zoneName(ProfileZone zone);
+    static const char* counterName(ProfileCounter counter);
+
+    static void beginFrame();
+    static void endFrame();
+
+    static void toggleOverlay();
+    static bool isOverlayVisible();
+    // Records the next frameCount frames and writes them to path as a Chrome trace
+    static void startCapture(const string& path, int frameCount = PROFILER_CAPTURE_FRAMES);
+    static bool isCapturing();
+    // Collects without the overlay, e.g. for headless runs
+    static void setEnabled(bool enable);
+
+    // Adds to a counter for the current frame
+    static void count(ProfileCounter counter, int amount);
+
+    static ProfileZoneStats zoneStats(ProfileZone zone);
+    // Per-frame average over the history window
+    static double counterAverage(ProfileCounter counter);
+    static void renderOverlay(SDL_Renderer* renderer, TextRenderer& textRenderer);
+    static void printSummary(ostream& out);
+    static bool writeChromeTrace(const string& path);
+};
+
+// Times the enclosing scope into zone
+class ProfileScope {
+private:
+    ProfileZone zone;
+    Uint64 start;
+
+public:
+    explicit ProfileScope(ProfileZone zone_)
+        : zone(zone_), start(SDL_AtomicGet(&Profiler::enabled) ? SDL_GetPerformanceCounter() : 0) {}
+
+    ~ProfileScope() {
+        if (start != 0) {
+            Profiler::record(zone, start, SDL_GetPerformanceCounter());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#endif // !PROFILER_H
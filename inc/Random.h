@@ -0,0 +1,49 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <SDL.h>
+
+// xoshiro128** generator: 16 bytes of state, cheap to seed and to step
+class Rng {
+private:
+    Uint32 state[4];
+
+public:
+    Rng(Uint64 seed = 0);
+
+    void seed(Uint64 seed);
+    Uint32 next();
+    // Uniform float in [min, max)
+    float uniform(float min, float max);
+    // Uniform int in [min, max], both inclusive
+    int uniformInt(int min, int max);
+};
+
+// Independent streams so e.g. extra VFX draws never shift enemy spawns
+enum class RngStream {
+    AI,
+    SPAWN,
+    VFX,
+    CAMERA,
+    COUNT
+};
+
+// Game-owned randomness: every stream is derived from one master seed,
+// so a whole run can be reproduced from that seed.
+class RandomService {
+private:
+    Uint64 masterSeed;
+    Rng streams[static_cast<int>(RngStream::COUNT)];
+
+public:
+    RandomService(Uint64 seed = 0);
+
+    void reseed(Uint64 seed);
+    // Restarts every stream for run number runIndex of this seed, so any run
+    // can be reproduced without replaying the ones before it
+    void beginRun(Uint32 runIndex);
+    Uint64 getSeed() const;
+    Rng& stream(RngStream id);
+};
+
+#endif // !RANDOM_H
@@ -0,0 +1,73 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Player input as the simulation sees it. handleGameEvents turns SDL events
+// into these and Game::update applies them at the start of the next tick, so
+// a recorded stream replays the same run without a window.
+enum class InputType : Uint8 {
+    AIM,          // angle: turret direction in radians
+    BUTTON_DOWN,  // code: InputButton
+    BUTTON_UP,
+    KEY_DOWN,     // code: InputKey
+    KEY_UP,
+    PAUSE_TOGGLE
+};
+
+enum InputButton : Uint8 {
+    INPUT_BUTTON_LEFT,
+    INPUT_BUTTON_RIGHT
+};
+
+enum InputKey : Uint8 {
+    INPUT_KEY_W,
+    INPUT_KEY_A,
+    INPUT_KEY_S,
+    INPUT_KEY_D,
+    INPUT_KEY_E,
+    INPUT_KEY_Q,
+    INPUT_KEY_T
+};
+
+struct InputEvent {
+    InputType type;
+    Uint8 code;
+    float angle;
+};
+
+struct ReplayInput {
+    Uint32 tick;       // Ticks since the run started
+    InputEvent event;
+};
+
+// One game from reset() to game over (or until recording stopped)
+struct ReplayRun {
+    Uint32 runIndex;   // Selects the random streams for this run, see RandomService::beginRun
+    Uint32 ticks;
+    Uint32 checksum;   // Game state after the last tick
+    vector<ReplayInput> inputs;
+};
+
+// A recorded session: the master seed and tick rate plus every run's inputs.
+// On disk: "TRPL", version, tick rate and seed, then per run a varint run
+// index and its records (varint tick delta, type, payload), ended by an end
+// record holding the remaining ticks and the checksum. Little-endian.
+class Replay {
+public:
+    int tickRate;
+    Uint64 masterSeed;
+    vector<ReplayRun> runs;
+
+    Replay();
+
+    void clear();
+    bool save(const string& path) const;
+    bool load(const string& path);
+};
+
+#endif // !REPLAY_H
@@ -5,29 +5,151 @@
 #include <SDL_image.h>
 #include <SDL_mixer.h>
 #include <iostream>
-#include <unordered_map>
 #include <string>
+#include <vector>
+
+#include "AssetIds.h"
+#include "AssetPack.h"
+#include "TextureAtlas.h"
 
 using namespace std;
 
+// Shapes ResourceManager can generate without an image file
+enum class ProceduralSprite {
+    CIRCLE,          // Solid white disc
+    RADIAL_GRADIENT, // White disc fading to transparent at the rim
+    COUNT
+};
+
+// Procedural sprites are cached per power-of-two radius, from 8 to 256 px
+constexpr int PROCEDURAL_RADIUS_BUCKETS = 6;
+
+// Assets are loaded in groups so the menu can appear before the game assets finish
+enum class LoadGroup {
+    MENU,
+    GAME,
+    COUNT
+};
+
+// Refers to an asset slot that the background loader fills in once the
+// asset is ready; until then it converts to nullptr like a missing asset.
+// Images use TextureHandle instead, since they may live on an atlas page.
+template <typename T>
+class AssetHandle {
+private:
+    T* const* slot;
+
+public:
+    AssetHandle(T* const* slot_ = nullptr) : slot(slot_) {}
+
+    T* get() const { return slot ? *slot : nullptr; }
+    operator T*() const { return get(); }
+    bool ready() const { return get() != nullptr; }
+};
+
+using SoundHandle = AssetHandle<Mix_Chunk>;
+using MusicHandle = AssetHandle<Mix_Music>;
+
 class ResourceManager {
 private:
-    static unordered_map<string, SDL_Texture*> textures;
-    static unordered_map<string, Mix_Chunk*> sounds;
-    static unordered_map<string, Mix_Music*> music;
+    enum class LoadKind {
+        TEXTURE,
+        RECOLORED_TEXTURE,
+        SOUND
+    };
+
+    // One asset for the background loader. Workers fill in surface/chunk
+    // (or error); the main thread uploads and publishes the result.
+    struct LoadJob {
+        LoadKind kind;
+        LoadGroup group;
+        int id;              // TextureId or SoundId
+        const char* path;
+        int sourceId;        // TextureId tinted from; recolored textures only
+        Uint8 r, g, b;
+        SDL_Surface* surface;
+        Mix_Chunk* chunk;
+        string error;
+    };
+
+    // Dense slots indexed by asset ID; nullptr until loaded
+    static TextureRegion regions[TEXTURE_COUNT];
+    static SDL_Texture* textures[TEXTURE_COUNT]; // Images with a texture of their own
+    static Mix_Chunk* sounds[SOUND_COUNT];
+    static Mix_Music* music[MUSIC_COUNT];
+    static const char* const texturePaths[TEXTURE_COUNT];
+    static const char* const soundPaths[SOUND_COUNT];
+    static const char* const musicPaths[MUSIC_COUNT];
+    static const LoadGroup textureGroups[TEXTURE_COUNT];
+    static const TexturePacking texturePacking[TEXTURE_COUNT];
+    // One atlas per group, built once the whole group has been decoded
+    static TextureAtlas atlases[static_cast<int>(LoadGroup::COUNT)];
+    static const LoadGroup soundGroups[SOUND_COUNT];
+    // Sources decoded once for recolouring and shared by every tint of them,
+    // so extra variants never re-read the file. Guarded by sourceMutex.
+    static SDL_Surface* sourceSurfaces[TEXTURE_COUNT];
+    static SDL_mutex* sourceMutex;
+    static SDL_Texture* proceduralTextures[static_cast<int>(ProceduralSprite::COUNT)][PROCEDURAL_RADIUS_BUCKETS];
+
+    static vector<LoadJob> loadJobs;
+    static vector<SDL_Thread*> loadWorkers;
+    static SDL_atomic_t nextLoadJob;    // Next job index a worker will claim
+    static SDL_mutex* decodedMutex;
+    static vector<int> decodedJobs;     // Decoded by workers, waiting for the main thread
+    static vector<int> pendingUploads;  // Taken from decodedJobs, not yet uploaded
+    static int jobsFinished;
+    static int groupRemaining[static_cast<int>(LoadGroup::COUNT)];
+    static AssetPack pack;
+
+    static SDL_Texture* createProceduralTexture(SDL_Renderer* renderer, ProceduralSprite sprite, int radius);
+    static SDL_Surface* loadSurface(const string& path);
+    static Mix_Chunk* loadChunk(const string& path);
+    // Decodes id on first use; callers hold sourceMutex
+    static SDL_Surface* getSourceSurface(TextureId id);
+    static SDL_Surface* recolorSurface(SDL_Surface* source, Uint8 r, Uint8 g, Uint8 b);
+    static int loadWorker(void* data);
+    static void decodeJob(LoadJob& job);
+    static void finishJob(LoadJob& job, SDL_Renderer* renderer);
+    static void buildAtlas(LoadGroup group, SDL_Renderer* renderer);
+    static void setTexture(TextureId id, SDL_Texture* texture);
+    static void stopLoading();
 
 public:
+    // Queues every asset the game uses and starts decoding them on worker threads
     static void init(SDL_Renderer* renderer);
     static void cleanup();
-    static SDL_Texture* loadTexture(const string& path, SDL_Renderer* renderer);
-    // New function to create a recolored texture
-    static SDL_Texture* createRecoloredTexture(const string& sourcePath, const string& newPath, SDL_Renderer* renderer,
-                                               Uint8 r, Uint8 g, Uint8 b);
-    static SDL_Texture* getTexture(const string& path);
-    static Mix_Chunk* loadSound(const string& path);
-    static Mix_Chunk* getSound(const string& path);
-    static Mix_Music* loadMusic(const string& path);
-    static Mix_Music* getMusic(const string& path);
+
+    // Maps a pack built by tools/AssetPacker; assets it contains skip file I/O and decoding
+    static bool openPack(const string& path);
+    // Packed file if present, otherwise the loose file; the caller owns the RWops
+    static SDL_RWops* openAsset(const string& path);
+
+    // Queue assets before startLoading(); the job list is fixed while workers run
+    static void queueTexture(TextureId id, LoadGroup group);
+    static void queueRecoloredTexture(TextureId source, TextureId id, Uint8 r, Uint8 g, Uint8 b, LoadGroup group);
+    static void queueSound(SoundId id, LoadGroup group);
+    static void startLoading();
+    // Uploads decoded assets on the calling (render) thread for up to budgetMs;
+    // returns true once every queued asset has been published
+    static bool pumpLoading(SDL_Renderer* renderer, Uint32 budgetMs);
+    static bool isGroupLoaded(LoadGroup group);
+    static float loadingProgress();
+
+    static TextureHandle textureHandle(TextureId id);
+    static SoundHandle soundHandle(SoundId id);
+    static MusicHandle musicHandle(MusicId id);
+    static const char* getPath(TextureId id);
+    static const char* getPath(SoundId id);
+    static const char* getPath(MusicId id);
+
+    // Loads the image now, as a texture of its own, unless it is already loaded
+    static TextureHandle loadTexture(TextureId id, SDL_Renderer* renderer);
+    // White sprite at least radius px in radius, meant to be tinted by colour mod or vertex colour
+    static SDL_Texture* getProceduralTexture(SDL_Renderer* renderer, ProceduralSprite sprite, int radius);
+    static Mix_Chunk* loadSound(SoundId id);
+    static Mix_Chunk* getSound(SoundId id);
+    static Mix_Music* loadMusic(MusicId id);
+    static Mix_Music* getMusic(MusicId id);
 };
 
 #endif // !RESOURCEMANAGER_H
@@ -0,0 +1,36 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include <vector>
+
+using namespace std;
+
+// Uniform grid over the arena used as a collision broad phase. Items are
+// binned by their centre; queries widen the search by the largest radius
+// inserted so every overlapping item is returned. Rebuilt once per tick.
+class SpatialGrid {
+private:
+    float cellSize;
+    int columns, rows;
+    float maxRadius;
+    vector<int> cellStart;   // Offset of each cell's items in cellItems (size columns * rows + 1)
+    vector<int> cellItems;   // Item indices sorted by cell
+    vector<int> pendingCell; // Cell of every inserted item, in insertion order
+    vector<int> pendingItem;
+
+    int cellX(float x) const;
+    int cellY(float y) const;
+
+public:
+    SpatialGrid(float worldWidth, float worldHeight, float cellSize_);
+
+    void clear();
+    void insert(int index, float x, float y, float radius);
+    // Sorts inserted items into their cells; call once after the inserts
+    void build();
+    // Replaces out with the indices of items that may overlap the circle, in ascending order.
+    // Items at or below after are skipped, so pair loops only see each pair once
+    void query(float x, float y, float radius, vector<int>& out, int after = -1) const;
+};
+
+#endif // !SPATIALGRID_H
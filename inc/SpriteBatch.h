@@ -0,0 +1,47 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SDL.h>
+#include <vector>
+
+using namespace std;
+
+// Collects rotated, tinted sprite quads and submits them with one
+// SDL_RenderGeometry call per texture. Tint and alpha go in the vertex
+// colours instead of texture mods, so sprites sharing an atlas page never
+// need the draw split up. Groups are drawn in the order their texture was
+// first used, each in the order its sprites were added; flush between
+// layers that must stack across textures.
+class SpriteBatch {
+private:
+    struct Group {
+        SDL_Texture* texture;   // nullptr for untextured quads
+        float invWidth, invHeight;
+        vector<SDL_Vertex> vertices;
+        size_t quadCount;
+    };
+
+    vector<Group> groups;   // Only the first groupCount are in use this batch
+    size_t groupCount;
+    size_t lastGroup;       // Consecutive sprites usually share a texture
+    vector<int> indices;
+    int drawCalls;          // SDL_RenderGeometry calls made by the last flush
+
+    Group& groupFor(SDL_Texture* texture);
+
+public:
+    SpriteBatch(size_t reserveQuads = 1024);
+
+    // Queues src of texture (nullptr for all of it) stretched over dest,
+    // rotated by angle radians clockwise about the centre of dest. Without a
+    // texture the quad is filled with tint.
+    void add(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dest, float angle = 0.0f,
+             SDL_Color tint = {255, 255, 255, 255});
+    size_t size() const;
+    int lastDrawCalls() const;
+    void clear();
+    // Draws every queued quad, one call per texture, then empties the batch
+    void flush(SDL_Renderer* renderer);
+};
+
+#endif // !SPRITEBATCH_H
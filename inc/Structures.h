@@ -1,8 +1,11 @@
 #ifndef STRUCTURES_H
 #define STRUCTURES_H
 
+#include "TextureAtlas.h"
+
 // Game states
 enum class GameState {
+    LOADING,
     MENU,
     PLAYING,
     PAUSED,
@@ -48,8 +51,8 @@ struct ButtonAnimation {
 // Menu button structure
 struct MenuButtonInfo {
     SDL_Rect rect;
-    SDL_Texture* texture;
-    SDL_Texture* hoverTexture;
+    TextureHandle texture;
+    TextureHandle hoverTexture;
     bool isHovered;
     MenuButton type;
 };
@@ -83,13 +86,49 @@ struct HealthRegenInfo {
     int amountHealed;
 };
 
+// Heading noise a basic tank takes this tick, drawn in enemy order before AI runs in parallel
+struct SteerJitter {
+    bool active;
+    float dx, dy;
+};
+
+// HudLayer widget ids for the in-game HUD
+struct HudWidgets {
+    int score, level, bulletsFired, tanksDestroyed;
+    int specialBullets, specialHint;
+    int shieldBar, shieldTimer, shieldReady;
+    int rapidFireBar, rapidFireTimer, rapidFireReady;
+    int healthPacks;
+    int minimap;
+};
+
 struct Particle {
     float x, y;
     float vx, vy;
-    int life;
-    int maxLife;
+    float life;    // Seconds left
+    float maxLife; // Seconds at spawn
     SDL_Color color;
-    bool active;
 };
 
+// What ParticleSystem does when an emit finds every slot in use
+enum class ParticleOverflow {
+    DROP,           // Skip the new particles
+    RECYCLE_OLDEST, // Overwrite live particles, cycling through the pool
+    GROW            // Double the pool
+};
+
+// How often the particle pool ran out of room
+struct ParticlePoolStats {
+    int saturations; // Emit calls that found the pool full
+    int dropped;     // Particles not emitted
+    int recycled;    // Live particles overwritten
+    int grown;       // Times the pool doubled
+};
+
+// True if a square of half-size extent around world point (x, y) touches the view
+inline bool overlapsView(float x, float y, float extent, const SDL_FRect& view) {
+    return x + extent >= view.x && x - extent <= view.x + view.w &&
+           y + extent >= view.y && y - extent <= view.y + view.h;
+}
+
 #endif // !STRUCTURES_H
@@ -5,13 +5,16 @@
 
 #include "Constants.h"
 #include "Structures.h"
+#include "TextureAtlas.h"
+#include "SpriteBatch.h"
 
+// The player's tank. Enemies live in EnemyPool.
 class Tank {
 public:
     float x, y, vx, vy, angle;
-    SDL_Texture* texture;
-    SDL_Texture* shieldTexture;  // Texture for shield animation
-    Uint32 lastShotTime;
+    float prevX, prevY, prevAngle; // State at the start of the current tick, for interpolation
+    TextureHandle texture;
+    TextureHandle shieldTexture; // Texture for shield animation
     bool alive;
     int hp, maxHp;
     bool isShooting;
@@ -24,8 +27,6 @@ public:
     float collisionRadius;
     float speed;
     int damage;
-    EnemyType type;
-    bool isPlayer; // Flag to indicate if this is the player tank
     int specialBullets;          // Count of special bullets accumulated
     bool isSpecialActive;        // Whether special ability is currently active
     float specialActivationTimer; // Timer for special ability activation
@@ -34,11 +35,16 @@ public:
     float healthRegenTimer;
     float healthRegenTickTimer;
 
-    Tank(float x_, float y_, SDL_Texture* tex, EnemyType type_ = EnemyType::BASIC);
+    Tank(float x_, float y_, TextureHandle tex);
 
-    void update(float deltaTime);
-    void render(SDL_Renderer* renderer, float cameraX, float cameraY);
-    void renderHealthBar(SDL_Renderer* renderer, float cameraX, float cameraY);
+    void update(float deltaTime, Uint32 currentTime);
+    void storePreviousState();
+    // Position and angle blended between the previous and current tick
+    float renderX(float alpha) const;
+    float renderY(float alpha) const;
+    float renderAngle(float alpha) const;
+    // Queues the current animation frame; the caller flushes the batch
+    void render(SpriteBatch& batch, float cameraX, float cameraY, float alpha = 1.0f);
     // Get bullet spawn position (for both regular and special bullets)
     void getBulletSpawnPosition(float& outX, float& outY);
 };
@@ -0,0 +1,54 @@
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+// Draws text from a glyph atlas baked once from the font. Each string's
+// quads are laid out once and cached, so redrawing unchanged text only
+// offsets and tints the cached vertices before one SDL_RenderGeometry call.
+class TextRenderer {
+private:
+    static constexpr int FIRST_GLYPH = 32;  // ' '
+    static constexpr int LAST_GLYPH = 126;  // '~'
+    static constexpr size_t MAX_CACHED_LAYOUTS = 512;
+
+    struct Glyph {
+        SDL_FRect uv;  // Normalised source rectangle in the atlas
+        int width;
+    };
+
+    // Quads for one string with its top-left corner at (0, 0)
+    struct TextLayout {
+        vector<SDL_Vertex> vertices;
+        int width;
+    };
+
+    SDL_Texture* atlas;
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+    int lineHeight;
+    unordered_map<string, TextLayout> layouts;
+    vector<SDL_Vertex> scratch;
+    vector<int> indices;
+
+    const TextLayout& layout(const string& text);
+
+public:
+    TextRenderer();
+    ~TextRenderer();
+
+    // Rasterises the printable ASCII glyphs of font into the atlas texture
+    bool init(SDL_Renderer* renderer, TTF_Font* font);
+    void destroy();
+
+    void draw(SDL_Renderer* renderer, const string& text, int x, int y, SDL_Color color);
+    int textWidth(const string& text);
+    int textHeight() const;
+};
+
+#endif // !TEXTRENDERER_H
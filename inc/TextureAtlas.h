@@ -0,0 +1,64 @@
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <SDL.h>
+#include <vector>
+
+using namespace std;
+
+// Where an image lives: a whole texture, or a rectangle on an atlas page
+struct TextureRegion {
+    SDL_Texture* texture;
+    SDL_Rect rect;
+};
+
+// Refers to a region ResourceManager fills in once the image is loaded;
+// until then texture() is nullptr, like a missing image.
+class TextureHandle {
+private:
+    const TextureRegion* region;
+
+public:
+    TextureHandle(const TextureRegion* region_ = nullptr) : region(region_) {}
+
+    SDL_Texture* texture() const { return region ? region->texture : nullptr; }
+    // Source rectangle to draw from texture(); only meaningful once ready()
+    const SDL_Rect* rect() const { return region ? &region->rect : nullptr; }
+    bool ready() const { return texture() != nullptr; }
+};
+
+// Shelf-packs images onto shared RGBA32 pages at load time, so sprites that
+// are drawn together come from one texture and SDL can batch their copies.
+// Collect images with add(), then build() packs and uploads them in one go.
+class TextureAtlas {
+private:
+    struct PendingImage {
+        int id;
+        SDL_Surface* surface;
+    };
+
+    vector<PendingImage> pending;
+    vector<SDL_Texture*> pages;
+    int maxPageSize;
+
+public:
+    struct Placement {
+        int id;
+        TextureRegion region;
+    };
+
+    TextureAtlas(int maxPageSize_ = 4096);
+
+    // Largest page side; clamp to the renderer's max texture size before adding
+    void setMaxPageSize(int size);
+    // Takes ownership of surface and returns true, or returns false if it can
+    // never fit on a page and should get a texture of its own
+    bool add(int id, SDL_Surface* surface);
+    bool hasPending() const;
+    // Packs and uploads everything added since the last build; one placement per image
+    vector<Placement> build(SDL_Renderer* renderer);
+    int pageCount() const;
+    void destroy();
+};
+
+#endif // !TEXTUREATLAS_H
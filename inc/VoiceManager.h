@@ -0,0 +1,86 @@
+#ifndef VOICEMANAGER_H
+#define VOICEMANAGER_H
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include "AssetIds.h"
+#include "AudioCommandQueue.h"
+#include "Constants.h"
+
+using namespace std;
+
+// Running totals of what happened to play() requests
+struct VoiceStats {
+    int requested;  // play() calls
+    int coalesced;  // Folded into another request for the same sound in the same tick
+    int started;    // Voices that began playing
+    int dropped;    // No voice free and nothing cheaper to steal
+    int stolen;     // Voices cut short to make room
+};
+
+// Deals the mixer's channels out to sound effects. play() only records a
+// request, from any thread, and endTick() closes the simulation tick it
+// belongs to, folding repeats of a sound within that tick into one voice.
+// update() runs once a frame on the main thread and starts a voice per
+// sound per finished tick, most important first, so a frame that covers
+// several ticks still hears each tick's shots. Each sound has a priority
+// and a cap on copies playing at once. Past the cap the sound restarts its
+// own oldest copy; with every channel busy it takes the oldest voice of the
+// lowest priority at or below its own, or is dropped. Until init() play()
+// does nothing.
+//
+// Nothing here takes SDL_mixer's lock on a game thread: update() and
+// setVolume() post commands to a lock-free queue that the mixer drains in
+// its post-mix hook, on the audio thread, which already holds the lock.
+// Channel-finished callbacks come back the same way, as counters.
+class VoiceManager {
+private:
+    struct Voice {
+        int sound;          // SoundId of the last voice started on the channel
+        int priority;
+        Uint32 startOrder;  // Older voices have lower numbers
+        int starts;         // PLAY commands sent to the channel
+    };
+
+    struct Request {
+        Mix_Chunk* chunk;
+        int count;      // play() calls in the tick still running
+        int ticks;      // Finished ticks that asked for the sound, one voice each
+        int requests;   // play() calls across those ticks
+    };
+
+    static bool initialized;
+    static SDL_SpinLock lock;               // Guards requests
+    static Request requests[SOUND_COUNT];
+    static Voice voices[AUDIO_VOICES];
+    static SDL_atomic_t finishes[AUDIO_VOICES]; // Voices ended per channel; busy while behind starts
+    static SDL_atomic_t failedStarts;           // PLAY commands the mixer refused
+    static AudioCommandQueue commands;
+    static Uint32 nextStartOrder;
+    static VoiceStats totals;
+
+    static bool isBusy(int channel);
+    static void start(int sound, Mix_Chunk* chunk);
+    static void playOn(int channel, int sound, Mix_Chunk* chunk);
+
+    // Audio thread
+    static void SDLCALL drainCommands(void* userdata, Uint8* stream, int length);
+    static void applyCommand(const AudioCommand& command);
+    static void SDLCALL channelFinished(int channel);
+
+public:
+    static void init();
+    static void shutdown();
+
+    // Queues sound for the next update(); safe from the simulation thread
+    static void play(SoundId sound, Mix_Chunk* chunk);
+    // Marks the end of a simulation tick; call after every step
+    static void endTick();
+    static void update();
+    // Effects volume, 0-128, for every channel
+    static void setVolume(int volume);
+    static VoiceStats stats();
+};
+
+#endif // !VOICEMANAGER_H
@@ -0,0 +1,83 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include <SDL.h>
+#include <vector>
+
+#include "Structures.h"
+#include "Tank.h"
+#include "EnemyPool.h"
+#include "BulletPool.h"
+#include "ParticleSystem.h"
+#include "Explosion.h"
+#include "PowerUp.h"
+#include "KillNotification.h"
+
+using namespace std;
+
+// Indices into a snapshot's entities that overlap the view, rebuilt by
+// WorldSnapshot::cull before anything is drawn
+struct VisibleSet {
+    vector<int> enemies;
+    vector<int> bullets;
+    vector<int> particles;
+    vector<int> powerups;
+    vector<int> explosions;
+};
+
+// Everything renderGame and the HUD draw, copied from the simulation after
+// a tick. The pools only hold the fields drawing reads.
+struct WorldSnapshot {
+    Uint32 time;                    // Simulation clock when published
+    Uint64 publishCounter;          // SDL_GetPerformanceCounter() when published
+    Uint64 tickCounter;             // Performance counter ticks per simulation tick
+    float publishAlpha;             // Fraction of the next tick already elapsed when published
+
+    float cameraX, cameraY;
+    float prevCameraX, prevCameraY;
+    Tank player;
+    EnemyPool enemies;
+    BulletPool bullets;
+    ParticleSystem particles;
+    vector<Explosion> explosions;
+    vector<PowerUp> powerups;
+    vector<KillNotification> killNotifications;
+
+    // HUD values
+    Stats stats;
+    RapidFire rapidFire;
+    HealthRegenInfo healthRegenInfo;
+    Uint32 shieldStartTime;
+    int shieldCooldownRemaining;
+
+    WorldSnapshot();
+
+    // Interpolation factor between the snapshot's two ticks at the given counter
+    float alphaAt(Uint64 counter) const;
+    // Lists what overlaps the world-space view rectangle at the given
+    // interpolation factor and counts the rest in the profiler
+    void cull(const SDL_FRect& view, float alpha, VisibleSet& visible) const;
+};
+
+// Triple buffer handing snapshots from the simulation thread to the drawing
+// thread without locks or copies: the simulation fills back() and publishes
+// it, the renderer takes the newest published one with acquire(). Neither
+// side ever waits, and each slot belongs to one side at a time.
+class SnapshotBuffer {
+private:
+    WorldSnapshot slots[3];
+    int writeSlot;
+    int readSlot;
+    SDL_atomic_t latest; // Slot published last, plus FRESH_SLOT until acquired
+
+public:
+    SnapshotBuffer();
+
+    // The slot to fill next; invisible to the renderer until publish()
+    WorldSnapshot& back();
+    void publish();
+    // The newest published snapshot; valid until the next call
+    WorldSnapshot& acquire();
+};
+
+#endif // !WORLDSNAPSHOT_H
@@ -1,8 +1,59 @@
-#include "core/Game.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "Game.h"
 
 using namespace std;
 
 int main(int argc, char* argv[]) {
     Game game;
-    return game.run();
+
+    // --seed <n>: master seed for all gameplay randomness
+    // --tick-rate <hz>: fixed simulation steps per second
+    // --headless [frames]: step the simulation only, no window or audio
+    // --profile: collect frame timings from the start (F3 shows them in-game)
+    // --horde: thousands of enemies, for stress testing
+    // --record <path>: save every run's input, to replay later
+    // --replay <path>: play a recording headless and check it still matches
+    // --threads <n>: simulation job threads, counting the main one (default: one per core)
+    // --audio-buffer <samples>: mixer buffer size; larger if the sound crackles
+    int headlessFrames = -1;
+    int threads = 0;
+    const char* replayPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            game.setSeed(strtoull(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+            game.setTickRate(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            headlessFrames = i + 1 < argc && argv[i + 1][0] != '-' ? atoi(argv[++i]) : 0;
+        } else if (strcmp(argv[i], "--profile") == 0) {
+            game.setProfiling(true);
+        } else if (strcmp(argv[i], "--horde") == 0) {
+            game.setHordeMode(true);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            game.setRecordPath(argv[++i]);
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayPath = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--audio-buffer") == 0 && i + 1 < argc) {
+            game.setAudioBufferSamples(atoi(argv[++i]));
+        }
+    }
+
+    JobSystem::init(threads);
+
+    int result;
+    if (replayPath) {
+        result = game.runReplay(replayPath);
+    } else if (headlessFrames >= 0) {
+        result = game.runHeadless(headlessFrames > 0 ? headlessFrames : 36000);
+    } else {
+        result = game.run();
+    }
+
+    JobSystem::shutdown();
+    return result;
 }
@@ -0,0 +1,138 @@
+#include "AssetPack.h"
+
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+AssetPack::AssetPack() : base(nullptr), mappedSize(0), fileHandle(nullptr), mappingHandle(nullptr) {}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+
+    base = static_cast<const Uint8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    mappedSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file alive on its own
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<const Uint8*>(mapped);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+
+    // Validate the header and table of contents before trusting any offsets
+    const AssetPackHeader* header = reinterpret_cast<const AssetPackHeader*>(base);
+    if (mappedSize < sizeof(AssetPackHeader) ||
+        memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != ASSET_PACK_VERSION ||
+        header->tocOffset > mappedSize ||
+        header->entryCount > (mappedSize - header->tocOffset) / sizeof(AssetPackEntry)) {
+        cerr << "Invalid asset pack " << path << endl;
+        close();
+        return false;
+    }
+
+    const AssetPackEntry* toc = reinterpret_cast<const AssetPackEntry*>(base + header->tocOffset);
+    for (Uint32 i = 0; i < header->entryCount; ++i) {
+        const AssetPackEntry& entry = toc[i];
+        if (entry.offset > mappedSize || entry.size > mappedSize - entry.offset) {
+            cerr << "Asset pack entry out of range: " << i << endl;
+            continue;
+        }
+        string name(entry.name, strnlen(entry.name, ASSET_PACK_NAME_LENGTH));
+        entries[name] = &entry;
+    }
+
+    return true;
+}
+
+void AssetPack::close() {
+    entries.clear();
+
+#ifdef _WIN32
+    if (base) {
+        UnmapViewOfFile(base);
+    }
+    if (mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+    }
+    if (fileHandle) {
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+    }
+#else
+    if (base) {
+        munmap(const_cast<Uint8*>(base), mappedSize);
+    }
+#endif
+
+    base = nullptr;
+    mappedSize = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool AssetPack::isOpen() const {
+    return base != nullptr;
+}
+
+const AssetPackEntry* AssetPack::find(const string& name) const {
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+const void* AssetPack::data(const AssetPackEntry& entry) const {
+    return base + entry.offset;
+}
@@ -0,0 +1,33 @@
+#include "AudioCommandQueue.h"
+
+AudioCommandQueue::AudioCommandQueue() {
+    SDL_AtomicSet(&writeIndex, 0);
+    SDL_AtomicSet(&readIndex, 0);
+}
+
+bool AudioCommandQueue::push(const AudioCommand& command) {
+    int write = SDL_AtomicGet(&writeIndex);
+    if (write - SDL_AtomicGet(&readIndex) >= CAPACITY) {
+        return false;
+    }
+
+    // Fill the slot before publishing the index that hands it to the consumer
+    commands[write & (CAPACITY - 1)] = command;
+    SDL_AtomicSet(&writeIndex, write + 1);
+    return true;
+}
+
+void AudioCommandQueue::drain(void (*apply)(const AudioCommand& command)) {
+    int read = SDL_AtomicGet(&readIndex);
+    int write = SDL_AtomicGet(&writeIndex);
+    for (; read != write; ++read) {
+        apply(commands[read & (CAPACITY - 1)]);
+    }
+
+    // The producer may reuse the slots from here on
+    SDL_AtomicSet(&readIndex, read);
+}
+
+void AudioCommandQueue::clear() {
+    SDL_AtomicSet(&readIndex, SDL_AtomicGet(&writeIndex));
+}
@@ -0,0 +1,157 @@
+#include "BulletPool.h"
+
+#include <algorithm>
+
+
+BulletPool::BulletPool(int capacity_) : capacity(capacity_), count(0) {
+    x.resize(capacity);
+    y.resize(capacity);
+    vx.resize(capacity);
+    vy.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    damage.resize(capacity);
+    flags.resize(capacity);
+}
+
+int BulletPool::size() const {
+    return count;
+}
+
+int BulletPool::spawn(float x_, float y_, float vx_, float vy_, bool enemy, int damage_, bool special) {
+    if (count >= capacity) {
+        return -1;
+    }
+
+    int i = count++;
+    x[i] = x_;
+    y[i] = y_;
+    vx[i] = vx_;
+    vy[i] = vy_;
+    prevX[i] = x_;
+    prevY[i] = y_;
+    damage[i] = damage_;
+    flags[i] = BULLET_ACTIVE | (enemy ? BULLET_FROM_ENEMY : 0) | (special ? BULLET_SPECIAL : 0);
+    return i;
+}
+
+bool BulletPool::isActive(int i) const {
+    return flags[i] & BULLET_ACTIVE;
+}
+
+bool BulletPool::isFromEnemy(int i) const {
+    return flags[i] & BULLET_FROM_ENEMY;
+}
+
+bool BulletPool::isSpecial(int i) const {
+    return flags[i] & BULLET_SPECIAL;
+}
+
+void BulletPool::kill(int i) {
+    flags[i] &= ~BULLET_ACTIVE;
+}
+
+void BulletPool::clear() {
+    count = 0;
+}
+
+void BulletPool::update(float deltaTime) {
+    const float step = deltaTime * 60.0f;
+    const float minX = BORDER_OFFSET;
+    const float maxX = MAP_WIDTH - BORDER_OFFSET;
+    const float minY = BORDER_OFFSET;
+    const float maxY = MAP_HEIGHT - BORDER_OFFSET;
+
+    float* __restrict px = x.data();
+    float* __restrict py = y.data();
+    const float* __restrict pvx = vx.data();
+    const float* __restrict pvy = vy.data();
+    Uint8* __restrict pflags = flags.data();
+
+    // Branch-free so the compiler can vectorise it. Dead bullets move too,
+    // which is harmless: they are removed by compact() before being drawn.
+    for (int i = 0; i < count; ++i) {
+        px[i] += pvx[i] * step;
+        py[i] += pvy[i] * step;
+        Uint8 inside = (px[i] >= minX) & (px[i] <= maxX) & (py[i] >= minY) & (py[i] <= maxY);
+        pflags[i] &= static_cast<Uint8>(~BULLET_ACTIVE | inside);
+    }
+}
+
+void BulletPool::storePreviousState() {
+    for (int i = 0; i < count; ++i) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+    }
+}
+
+void BulletPool::compact() {
+    int i = 0;
+    while (i < count) {
+        if (flags[i] & BULLET_ACTIVE) {
+            ++i;
+            continue;
+        }
+
+        // Swap-and-pop: move the last bullet into the dead slot
+        int last = --count;
+        x[i] = x[last];
+        y[i] = y[last];
+        vx[i] = vx[last];
+        vy[i] = vy[last];
+        prevX[i] = prevX[last];
+        prevY[i] = prevY[last];
+        damage[i] = damage[last];
+        flags[i] = flags[last];
+    }
+}
+
+void BulletPool::copyForRender(const BulletPool& source) {
+    count = source.count;
+    copy_n(source.x.begin(), count, x.begin());
+    copy_n(source.y.begin(), count, y.begin());
+    copy_n(source.prevX.begin(), count, prevX.begin());
+    copy_n(source.prevY.begin(), count, prevY.begin());
+    copy_n(source.flags.begin(), count, flags.begin());
+}
+
+int BulletPool::cull(const SDL_FRect& view, float alpha, vector<int>& visible) const {
+    visible.clear();
+    int culled = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!(flags[i] & BULLET_ACTIVE)) {
+            continue;
+        }
+
+        // Special bullets are the larger, 10px square
+        float drawX = prevX[i] + (x[i] - prevX[i]) * alpha;
+        float drawY = prevY[i] + (y[i] - prevY[i]) * alpha;
+        if (overlapsView(drawX, drawY, 5.0f, view)) {
+            visible.push_back(i);
+        } else {
+            ++culled;
+        }
+    }
+    return culled;
+}
+
+void BulletPool::render(GeometryBatch& batch, const vector<int>& visible, float cameraX, float cameraY, float alpha) {
+    const SDL_Color specialColor = {255, 0, 255, 255};
+    const SDL_Color enemyColor = {0, 0, 255, 255};
+    const SDL_Color playerColor = {255, 0, 0, 255};
+
+    for (int i : visible) {
+        float drawX = prevX[i] + (x[i] - prevX[i]) * alpha;
+        float drawY = prevY[i] + (y[i] - prevY[i]) * alpha;
+
+        if (flags[i] & BULLET_SPECIAL) {
+            batch.addRect(static_cast<float>(static_cast<int>(drawX - 5 - cameraX)),
+                          static_cast<float>(static_cast<int>(drawY - 5 - cameraY)),
+                          10.0f, 10.0f, specialColor);
+        } else {
+            batch.addRect(static_cast<float>(static_cast<int>(drawX - 3 - cameraX)),
+                          static_cast<float>(static_cast<int>(drawY - 3 - cameraY)),
+                          6.0f, 6.0f, (flags[i] & BULLET_FROM_ENEMY) ? enemyColor : playerColor);
+        }
+    }
+}
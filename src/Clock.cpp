@@ -0,0 +1,15 @@
+#include "Clock.h"
+
+Uint32 SystemClock::now() const {
+    return SDL_GetTicks();
+}
+
+ManualClock::ManualClock(Uint32 start) : time(start) {}
+
+Uint32 ManualClock::now() const {
+    return static_cast<Uint32>(time);
+}
+
+void ManualClock::advance(float seconds) {
+    time += seconds * 1000.0;
+}
@@ -0,0 +1,24 @@
+#include "CommandBuffer.h"
+
+void CommandBuffer::clear() {
+    bulletSpawns.clear();
+    particleBursts.clear();
+}
+
+void CommandBuffer::spawnBullet(float x, float y, float vx, float vy, bool enemy, int damage) {
+    bulletSpawns.push_back({x, y, vx, vy, enemy, damage});
+}
+
+void CommandBuffer::emitParticles(float x, float y, float angle, int count, SDL_Color color) {
+    particleBursts.push_back({x, y, angle, count, color});
+}
+
+void CommandBuffer::apply(BulletPool& bullets, ParticleSystem& particles) const {
+    // Bullets and particles live in separate pools, so only the order within each matters
+    for (const BulletSpawn& spawn : bulletSpawns) {
+        bullets.spawn(spawn.x, spawn.y, spawn.vx, spawn.vy, spawn.enemy, spawn.damage);
+    }
+    for (const ParticleBurst& burst : particleBursts) {
+        particles.emit(burst.x, burst.y, burst.angle, burst.count, burst.color);
+    }
+}
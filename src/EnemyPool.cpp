@@ -0,0 +1,243 @@
+#include "EnemyPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+EnemyPool::EnemyPool(int capacity_) : capacity(capacity_), count(0) {
+    x.resize(capacity);
+    y.resize(capacity);
+    vx.resize(capacity);
+    vy.resize(capacity);
+    angle.resize(capacity);
+    radius.resize(capacity);
+    hp.resize(capacity);
+    alive.resize(capacity);
+    prevX.resize(capacity);
+    prevY.resize(capacity);
+    prevAngle.resize(capacity);
+    type.resize(capacity);
+    speed.resize(capacity);
+    damage.resize(capacity);
+    lastShotTime.resize(capacity);
+    width.resize(capacity);
+    height.resize(capacity);
+    maxHp.resize(capacity);
+}
+
+int EnemyPool::size() const {
+    return count;
+}
+
+int EnemyPool::spawn(float x_, float y_, EnemyType type_) {
+    if (count >= capacity) {
+        return -1;
+    }
+
+    int i = count++;
+    x[i] = x_;
+    y[i] = y_;
+    vx[i] = 0.0f;
+    vy[i] = 0.0f;
+    angle[i] = 0.0f;
+    prevX[i] = x_;
+    prevY[i] = y_;
+    prevAngle[i] = 0.0f;
+    alive[i] = 1;
+    type[i] = type_;
+    lastShotTime[i] = 0;
+
+    // Per-type stats, unchanged from when enemies were Tank objects
+    if (type_ == EnemyType::FAST) {
+        speed[i] = 1.5f;
+        hp[i] = 70;
+        damage[i] = 5;
+        width[i] = 80;
+        height[i] = 40;
+        radius[i] = 25.0f;
+    } else if (type_ == EnemyType::HEAVY) {
+        speed[i] = 0.7f;
+        hp[i] = 150;
+        damage[i] = 15;
+        width[i] = 100;
+        height[i] = 50;
+        radius[i] = 35.0f;
+    } else {
+        speed[i] = 1.0f;
+        hp[i] = 100;
+        damage[i] = 10;
+        width[i] = 150;
+        height[i] = 50;
+        radius[i] = 30.0f;
+    }
+    maxHp[i] = hp[i];
+    return i;
+}
+
+bool EnemyPool::isAlive(int i) const {
+    return alive[i] != 0;
+}
+
+void EnemyPool::kill(int i) {
+    alive[i] = 0;
+}
+
+void EnemyPool::clear() {
+    count = 0;
+}
+
+void EnemyPool::update(float deltaTime) {
+    update(deltaTime, 0, count);
+}
+
+void EnemyPool::update(float deltaTime, int begin, int end) {
+    // Friction tuned as 0.95 per 1/60 s step, scaled so any tick rate agrees
+    const float damping = pow(0.95f, deltaTime * 60.0f);
+
+    for (int i = begin; i < end; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+
+        float maxSpeed = speed[i] * 3.0f;
+        float velX = max(-maxSpeed, min(vx[i], maxSpeed));
+        float velY = max(-maxSpeed, min(vy[i], maxSpeed));
+
+        x[i] += velX * deltaTime * 60.0f;
+        y[i] += velY * deltaTime * 60.0f;
+
+        velX *= damping;
+        velY *= damping;
+        vx[i] = abs(velX) < 0.01f ? 0.0f : velX;
+        vy[i] = abs(velY) < 0.01f ? 0.0f : velY;
+    }
+}
+
+void EnemyPool::storePreviousState() {
+    for (int i = 0; i < count; ++i) {
+        prevX[i] = x[i];
+        prevY[i] = y[i];
+        prevAngle[i] = angle[i];
+    }
+}
+
+void EnemyPool::compact() {
+    // Stable, unlike BulletPool: enemies act in spawn order
+    int out = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+        if (out != i) {
+            x[out] = x[i];
+            y[out] = y[i];
+            vx[out] = vx[i];
+            vy[out] = vy[i];
+            angle[out] = angle[i];
+            radius[out] = radius[i];
+            hp[out] = hp[i];
+            alive[out] = alive[i];
+            prevX[out] = prevX[i];
+            prevY[out] = prevY[i];
+            prevAngle[out] = prevAngle[i];
+            type[out] = type[i];
+            speed[out] = speed[i];
+            damage[out] = damage[i];
+            lastShotTime[out] = lastShotTime[i];
+            width[out] = width[i];
+            height[out] = height[i];
+            maxHp[out] = maxHp[i];
+        }
+        ++out;
+    }
+    count = out;
+}
+
+void EnemyPool::copyForRender(const EnemyPool& source) {
+    count = source.count;
+    copy_n(source.x.begin(), count, x.begin());
+    copy_n(source.y.begin(), count, y.begin());
+    copy_n(source.angle.begin(), count, angle.begin());
+    copy_n(source.hp.begin(), count, hp.begin());
+    copy_n(source.alive.begin(), count, alive.begin());
+    copy_n(source.prevX.begin(), count, prevX.begin());
+    copy_n(source.prevY.begin(), count, prevY.begin());
+    copy_n(source.prevAngle.begin(), count, prevAngle.begin());
+    copy_n(source.width.begin(), count, width.begin());
+    copy_n(source.height.begin(), count, height.begin());
+    copy_n(source.maxHp.begin(), count, maxHp.begin());
+}
+
+float EnemyPool::renderX(int i, float alpha) const {
+    return prevX[i] + (x[i] - prevX[i]) * alpha;
+}
+
+float EnemyPool::renderY(int i, float alpha) const {
+    return prevY[i] + (y[i] - prevY[i]) * alpha;
+}
+
+float EnemyPool::renderAngle(int i, float alpha) const {
+    // Blend along the shorter arc so a wrap at +-PI does not spin the sprite
+    float diff = angle[i] - prevAngle[i];
+    while (diff > M_PI) diff -= 2 * M_PI;
+    while (diff < -M_PI) diff += 2 * M_PI;
+    return prevAngle[i] + diff * alpha;
+}
+
+int EnemyPool::cull(const SDL_FRect& view, float alpha, vector<int>& visible) const {
+    visible.clear();
+    int culled = 0;
+    for (int i = 0; i < count; ++i) {
+        if (!alive[i]) {
+            continue;
+        }
+
+        // Half the sprite's width plus height bounds it at any rotation; the
+        // health bar adds 10px above
+        if (overlapsView(renderX(i, alpha), renderY(i, alpha), (width[i] + height[i]) / 2.0f + 10.0f, view)) {
+            visible.push_back(i);
+        } else {
+            ++culled;
+        }
+    }
+    return culled;
+}
+
+void EnemyPool::render(SpriteBatch& batch, TextureHandle texture, const vector<int>& visible,
+                       float cameraX, float cameraY, float alpha) {
+    if (!texture.ready()) {
+        return;
+    }
+
+    // Enemies never play the firing animation, so every one uses the first frame
+    const SDL_Rect* sheet = texture.rect();
+    SDL_Rect srcRect = {sheet->x, sheet->y, TANK_FRAME_WIDTH, TANK_FRAME_HEIGHT};
+
+    for (int i : visible) {
+        SDL_FRect destRect = {
+            static_cast<float>(static_cast<int>(renderX(i, alpha) - width[i] / 2 - cameraX)),
+            static_cast<float>(static_cast<int>(renderY(i, alpha) - height[i] / 2 - cameraY)),
+            static_cast<float>(width[i]), static_cast<float>(height[i])
+        };
+        batch.add(texture.texture(), &srcRect, destRect, renderAngle(i, alpha));
+    }
+}
+
+void EnemyPool::renderHealthBars(GeometryBatch& batch, const vector<int>& visible,
+                                 float cameraX, float cameraY, float alpha) {
+    const SDL_Color backColor = {255, 0, 0, 255};
+    const SDL_Color fillColor = {0, 255, 0, 255};
+    const int barHeight = 5;
+
+    for (int i : visible) {
+        // The bar is as wide as the tank and sits 10px above it
+        int barWidth = width[i];
+        int offsetY = -(height[i] / 2 + 10);
+        float barX = static_cast<float>(static_cast<int>(renderX(i, alpha) - barWidth / 2 - cameraX));
+        float barY = static_cast<float>(static_cast<int>(renderY(i, alpha) + offsetY - cameraY));
+        float hpRatio = static_cast<float>(hp[i]) / maxHp[i];
+
+        batch.addRect(barX, barY, static_cast<float>(barWidth), static_cast<float>(barHeight), backColor);
+        batch.addRect(barX, barY, static_cast<float>(static_cast<int>(barWidth * hpRatio)),
+                      static_cast<float>(barHeight), fillColor);
+    }
+}
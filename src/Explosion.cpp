@@ -4,60 +4,61 @@
 #include "Structures.h"
 #include "ResourceManager.h"
 
-Explosion::Explosion(float x_, float y_, bool special)
-    : x(x_), y(y_), startTime(SDL_GetTicks()), active(true), isSpecial(special) {
-    texture = ResourceManager::getTexture("assets/images/effect/explosion.png");
+Explosion::Explosion(float x_, float y_, Uint32 currentTime, bool special)
+    : x(x_), y(y_), startTime(currentTime), progress(0.0f), active(true), isSpecial(special) {
+    texture = ResourceManager::textureHandle(TextureId::EXPLOSION);
 }
 
-void Explosion::render(SDL_Renderer* renderer, float cameraX, float cameraY) {
+void Explosion::update(Uint32 currentTime) {
     if (!active) {
         return;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
-    float progress = (currentTime - startTime) / static_cast<float>(EXPLOSION_DURATION);
+    progress = (currentTime - startTime) / static_cast<float>(EXPLOSION_DURATION);
     if (progress > 1.0f) {
         active = false;
-        return;
     }
+}
 
+void Explosion::render(SpriteBatch& batch, SDL_Renderer* renderer, float cameraX, float cameraY) {
+    if (!active) {
+        return;
+    }
 
-    if (texture) {
+    Uint8 fade = static_cast<Uint8>(255 * (1.0f - progress));
+    if (texture.ready()) {
         int size = static_cast<int>(EXPLOSION_RADIUS * 2 * (1.0f - progress * 0.5f) * (isSpecial ? 2.0f : 1.0f));
-        SDL_Rect destRect = {
-            static_cast<int>(x - size / 2 - cameraX),
-            static_cast<int>(y - size / 2 - cameraY),
-            size,
-            size
+        SDL_FRect destRect = {
+            static_cast<float>(static_cast<int>(x - size / 2 - cameraX)),
+            static_cast<float>(static_cast<int>(y - size / 2 - cameraY)),
+            static_cast<float>(size),
+            static_cast<float>(size)
         };
 
-        SDL_SetTextureAlphaMod(texture, static_cast<Uint8>(255 * (1.0f - progress)));
-
-        if (isSpecial) {
-            SDL_SetTextureColorMod(texture, 255, 100, 255);
-        } else {
-            SDL_SetTextureColorMod(texture, 255, 255, 255);
-        }
-
-        SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+        // Special explosions are tinted magenta and both fade out, all through
+        // the vertex colour so the shared atlas page stays unmodulated
+        SDL_Color tint = isSpecial ? SDL_Color{255, 100, 255, fade} : SDL_Color{255, 255, 255, fade};
+        batch.add(texture.texture(), texture.rect(), destRect, 0.0f, tint);
     } else {
-        int red = 255;
-        int green = static_cast<int>(255 * progress);
-        int blue = isSpecial ? 255 : 0;
-        SDL_SetRenderDrawColor(renderer, red, green, blue, 255);
+        // No image: tint a generated disc instead of filling it pixel by pixel
         int radius = static_cast<int>(EXPLOSION_RADIUS * (1.0f - progress) * (isSpecial ? 2.0f : 1.0f));
-        int centerX = static_cast<int>(x - cameraX);
-        int centerY = static_cast<int>(y - cameraY);
-
-        for (int w = 0; w < radius * 2; w++) {
-            for (int h = 0; h < radius * 2; h++) {
-                int dx = w - radius;
-                int dy = h - radius;
-                if (dx * dx + dy * dy <= radius * radius) {
-                    SDL_Rect pixel = {centerX + dx, centerY + dy, 1, 1};
-                    SDL_RenderFillRect(renderer, &pixel);
-                }
-            }
+        if (radius <= 0) {
+            return;
+        }
+
+        ProceduralSprite shape = isSpecial ? ProceduralSprite::RADIAL_GRADIENT : ProceduralSprite::CIRCLE;
+        SDL_Texture* sprite = ResourceManager::getProceduralTexture(renderer, shape, radius);
+        if (!sprite) {
+            return;
         }
+
+        SDL_FRect destRect = {
+            static_cast<float>(static_cast<int>(x - cameraX) - radius),
+            static_cast<float>(static_cast<int>(y - cameraY) - radius),
+            static_cast<float>(radius * 2),
+            static_cast<float>(radius * 2)
+        };
+        SDL_Color tint = {255, static_cast<Uint8>(255 * progress), static_cast<Uint8>(isSpecial ? 255 : 0), 255};
+        batch.add(sprite, nullptr, destRect, 0.0f, tint);
     }
 }
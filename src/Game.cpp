@@ -3,7 +3,6 @@
 #include <array>
 #include <cmath>
 #include <iostream>
-#include <random>
 #include <chrono>
 #include <string>
 #include <unordered_map>
@@ -17,7 +16,11 @@ Game::Game() : renderer(nullptr), font(nullptr),
       state(GameState::MENU),
       menuBackgroundTexture(nullptr),
       player(MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f, nullptr),
+      particles(MAX_PARTICLES),
+      enemyGrid(MAP_WIDTH, MAP_HEIGHT, COLLISION_CELL_SIZE),
+      powerUpGrid(MAP_WIDTH, MAP_HEIGHT, COLLISION_CELL_SIZE),
       cameraX(0), cameraY(0),
+      prevCameraX(0), prevCameraY(0),
       lastSpawnTime(0),
       lastPowerUpTime(0),
       lastHealthPickupTime(0),
@@ -30,7 +33,9 @@ Game::Game() : renderer(nullptr), font(nullptr),
       currentCameraZoom(1.0f),
       paused(false),
       difficulty(1),
-      gameTime(0.0f) {
+      gameTime(0.0f),
+      clock(&systemClock),
+      random(chrono::steady_clock::now().time_since_epoch().count()) {
     stats = {0, 0, 0, 1};
     rapidFire = {false, 0, 0, 0, 0};
     screenShake = {false, 0.0f, 0, 0};
@@ -49,31 +54,18 @@ Game::Game() : renderer(nullptr), font(nullptr),
     playerShieldTexture = nullptr;
     player.texture = playerTexture;
     player.shieldTexture = playerShieldTexture;
-    player.isPlayer = true;
     currentHoveredButton = MenuButton::START;
+    particles.setRng(&random.stream(RngStream::VFX));
 }
 
 Game::~Game() {
-    // Cleanup menu resources
-    if (menuBackgroundTexture) {
-        SDL_DestroyTexture(menuBackgroundTexture);
-    }
-    for (auto& button : menuButtons) {
-        if (button.texture) {
-            SDL_DestroyTexture(button.texture);
-        }
-        if (button.hoverTexture) {
-            SDL_DestroyTexture(button.hoverTexture);
-        }
-    }
+    // Menu textures are owned by ResourceManager
     menuButtons.clear();
 
     ResourceManager::cleanup();
 }
 
 int Game::run() {
-    srand(static_cast<unsigned>(time(nullptr)));
-
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
         cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << endl;
         return 1;
@@ -86,12 +78,13 @@ int Game::run() {
         return 1;
     }
 
-    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, audioBufferSamples) < 0) {
         cerr << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << endl;
         IMG_Quit();
         SDL_Quit();
         return 1;
     }
+    VoiceManager::init();
 
 
     if (TTF_Init() < 0) {
@@ -124,7 +117,10 @@ int Game::run() {
         return 1;
     }
 
-    TTF_Font* font = TTF_OpenFont("assets/fonts/VCR_OSD_MONO_1.001.ttf", 24);
+    // Optional: built with `make pack`, otherwise the loose files are used
+    ResourceManager::openPack("assets.pack");
+
+    TTF_Font* font = TTF_OpenFontRW(ResourceManager::openAsset("assets/fonts/VCR_OSD_MONO_1.001.ttf"), 1, 24);
     if (!font) {
         cerr << "Failed to load font! TTF_Error: " << TTF_GetError() << endl;
         SDL_DestroyRenderer(renderer);
@@ -141,32 +137,103 @@ int Game::run() {
 
     bool quit = false;
     SDL_Event e;
-    Uint32 lastTime = SDL_GetTicks();
-    Uint32 currentTime;
-    float deltaTime;
 
-    // Game loop
+    // Without vsync nothing paces the loop, so yield a little each frame
+    SDL_RendererInfo rendererInfo;
+    bool vsync = SDL_GetRendererInfo(renderer, &rendererInfo) == 0 &&
+                 (rendererInfo.flags & SDL_RENDERER_PRESENTVSYNC);
+
+    setClock(&simulationClock);
+
+    // Fixed simulation steps run on their own thread, so a slow present or
+    // vsync wait never holds up ticks. Events and drawing stay on this thread,
+    // as SDL wants them on the one that created the window.
+    simulationMutex = SDL_CreateMutex();
+    SDL_AtomicSet(&simulationQuit, 0);
+    if (simulationMutex) {
+        simulationThread = SDL_CreateThread(simulationMain, "Simulation", this);
+    }
+    if (!simulationThread) {
+        cerr << "Unable to start simulation thread! SDL_Error: " << SDL_GetError() << endl;
+    }
+
+    // Without a simulation thread, ticks run between frames on this one
+    Uint64 counterFrequency = SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+
     while (!quit) {
-        while (SDL_PollEvent(&e) != 0) {
-            handleEvents(e, quit);
+        Profiler::beginFrame();
+
+        // Everything the simulation also touches is changed under its lock
+        GameState frameState;
+        SDL_LockMutex(simulationMutex);
+        {
+            ProfileScope scope(ProfileZone::EVENTS);
+            while (SDL_PollEvent(&e) != 0) {
+                handleEvents(e, quit);
+            }
         }
 
+        if (!assetsLoaded) {
+            ProfileScope scope(ProfileZone::LOADING);
+            updateLoading();
+        }
 
-        currentTime = SDL_GetTicks();
-        deltaTime = (currentTime - lastTime) / 1000.0f;
-        lastTime = currentTime;
+        if (!simulationThread) {
+            Uint64 currentCounter = SDL_GetPerformanceCounter();
+            double frameTime = static_cast<double>(currentCounter - lastCounter) / counterFrequency;
+            lastCounter = currentCounter;
 
+            // Drop time after a long stall instead of trying to catch up with it
+            accumulator += min(frameTime, static_cast<double>(MAX_FRAME_TIME));
 
-        update(deltaTime);
+            const float tickTime = 1.0f / tickRate;
+            while (accumulator >= tickTime) {
+                simulationClock.advance(tickTime);
+                update(tickTime);
+                VoiceManager::endTick();
+                accumulator -= tickTime;
+            }
+            publishSnapshot(static_cast<float>(accumulator / tickTime));
+        }
+        frameState = state;
+        SDL_UnlockMutex(simulationMutex);
+
+        // Start the sounds the ticks finished since the last frame asked for
+        VoiceManager::update();
 
+        render(frameState);
 
-        render();
+        Profiler::endFrame();
 
+        if (!vsync) {
+            SDL_Delay(1);
+        }
+    }
 
-        SDL_Delay(16);
+    if (simulationThread) {
+        SDL_AtomicSet(&simulationQuit, 1);
+        SDL_WaitThread(simulationThread, nullptr);
+        simulationThread = nullptr;
+    }
+    if (simulationMutex) {
+        SDL_DestroyMutex(simulationMutex);
+        simulationMutex = nullptr;
     }
 
+    finishRun();
 
+    // Voice totals go out alongside the --profile timings
+    if (profileHeadless) {
+        VoiceStats voiceStats = VoiceManager::stats();
+        cout << "Voices: " << voiceStats.started << " started, " << voiceStats.coalesced << " coalesced, "
+             << voiceStats.dropped << " dropped, " << voiceStats.stolen << " stolen" << endl;
+    }
+    VoiceManager::shutdown();
+
+    hud.destroy();
+    textRenderer.destroy();
     TTF_CloseFont(font);
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
@@ -178,9 +245,228 @@ int Game::run() {
     return 0;
 }
 
+int Game::simulationMain(void* data) {
+    static_cast<Game*>(data)->runSimulation();
+    return 0;
+}
+
+void Game::runSimulation() {
+    Uint64 counterFrequency = SDL_GetPerformanceFrequency();
+    Uint64 lastCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+
+    while (!SDL_AtomicGet(&simulationQuit)) {
+        Uint64 currentCounter = SDL_GetPerformanceCounter();
+        double frameTime = static_cast<double>(currentCounter - lastCounter) / counterFrequency;
+        lastCounter = currentCounter;
+
+        // Drop time after a long stall instead of trying to catch up with it
+        accumulator += min(frameTime, static_cast<double>(MAX_FRAME_TIME));
+
+        const float tickTime = 1.0f / tickRate;
+        if (accumulator >= tickTime) {
+            SDL_LockMutex(simulationMutex);
+            while (accumulator >= tickTime) {
+                simulationClock.advance(tickTime);
+                update(tickTime);
+                VoiceManager::endTick();
+                accumulator -= tickTime;
+            }
+            publishSnapshot(static_cast<float>(accumulator / tickTime));
+            SDL_UnlockMutex(simulationMutex);
+        }
+
+        SDL_Delay(1);
+    }
+}
+
+void Game::publishSnapshot(float alpha) {
+    // Menus draw nothing from the world
+    if (state != GameState::PLAYING && state != GameState::PAUSED && state != GameState::GAME_OVER) {
+        return;
+    }
+
+    WorldSnapshot& world = snapshots.back();
+    world.time = clock->now();
+    world.publishCounter = SDL_GetPerformanceCounter();
+    world.tickCounter = SDL_GetPerformanceFrequency() / tickRate;
+    world.publishAlpha = alpha;
+
+    world.cameraX = cameraX;
+    world.cameraY = cameraY;
+    world.prevCameraX = prevCameraX;
+    world.prevCameraY = prevCameraY;
+    world.player = player;
+    world.enemies.copyForRender(enemies);
+    world.bullets.copyForRender(bullets);
+    world.particles.copyForRender(particles);
+    world.explosions = explosions;
+    world.powerups = powerups;
+    world.killNotifications = killNotifications;
+
+    world.stats = stats;
+    world.rapidFire = rapidFire;
+    world.healthRegenInfo = healthRegenInfo;
+    world.shieldStartTime = shieldStartTime;
+    world.shieldCooldownRemaining = shieldCooldownRemaining;
+
+    snapshots.publish();
+}
+
+int Game::runHeadless(int frames) {
+    // No window, renderer, mixer or fonts: textures and sounds stay null and
+    // every play/render path already skips null resources.
+    const float deltaTime = 1.0f / tickRate;
+    setClock(&simulationClock);
+    headless = true;
+
+    state = GameState::PLAYING;
+    reset();
+
+    int gamesPlayed = 1;
+    long long totalScore = 0;
+    auto wallStart = chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame) {
+        Profiler::beginFrame();
+        simulationClock.advance(deltaTime);
+        updateHeadlessPlayer();
+        update(deltaTime);
+        Profiler::endFrame();
+
+        if (state == GameState::GAME_OVER) {
+            totalScore += stats.score;
+            gamesPlayed++;
+            state = GameState::PLAYING;
+            reset();
+        }
+    }
+    totalScore += stats.score;
+    finishRun();
+
+    double wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    cout << "Headless run: " << frames << " frames in " << wallSeconds << "s ("
+         << (wallSeconds > 0 ? frames / wallSeconds : 0.0) << " frames/s, "
+         << (frames > 0 ? wallSeconds * 1e6 / frames : 0.0) << " us/frame)" << endl;
+    cout << "Games: " << gamesPlayed << ", total score: " << totalScore
+         << ", simulated time: " << static_cast<float>(frames) / tickRate << "s" << endl;
+
+    const ParticlePoolStats& particleStats = particles.getStats();
+    cout << "Particles: pool " << particles.capacity() << ", saturated " << particleStats.saturations
+         << " times, dropped " << particleStats.dropped << ", recycled " << particleStats.recycled
+         << ", grown " << particleStats.grown << endl;
+
+    if (profileHeadless) {
+        cout << "Profile of the last " << min(frames, PROFILER_HISTORY_FRAMES) << " frames:" << endl;
+        Profiler::printSummary(cout);
+    }
+
+    setClock(&systemClock);
+    headless = false;
+    return 0;
+}
+
+void Game::setClock(Clock* c) {
+    clock = c ? c : &systemClock;
+}
+
+void Game::setSeed(Uint64 seed) {
+    random.reseed(seed);
+}
+
+void Game::setTickRate(int hz) {
+    tickRate = max(10, min(hz, 1000));
+}
+
+void Game::setAudioBufferSamples(int samples) {
+    // SDL wants a power of two; smaller buffers cut latency but underrun sooner
+    int size = 128;
+    while (size < samples && size < 4096) {
+        size *= 2;
+    }
+    audioBufferSamples = size;
+}
+
+void Game::setHordeMode(bool enable) {
+    hordeMode = enable;
+}
+
+void Game::setProfiling(bool enable) {
+    profileHeadless = enable;
+    Profiler::setEnabled(enable);
+}
+
+void Game::setRecordPath(const string& path) {
+    recordPath = path;
+}
+
+int Game::runReplay(const string& path) {
+    Replay replay;
+    if (!replay.load(path)) {
+        return 1;
+    }
+
+    setTickRate(replay.tickRate);
+    setSeed(replay.masterSeed);
+    setClock(&simulationClock);
+    headless = true;
+
+    int mismatches = 0;
+    long long totalTicks = 0;
+    long long totalScore = 0;
+    auto wallStart = chrono::steady_clock::now();
+
+    for (const ReplayRun& run : replay.runs) {
+        if (!playReplayRun(run)) {
+            cerr << "Replay run " << run.runIndex << " diverged: checksum " << stateChecksum()
+                 << ", recorded " << run.checksum << endl;
+            mismatches++;
+        }
+        totalTicks += run.ticks;
+        totalScore += stats.score;
+    }
+
+    double wallSeconds = chrono::duration<double>(chrono::steady_clock::now() - wallStart).count();
+    cout << "Replay " << path << ": " << replay.runs.size() << " runs, " << totalTicks << " ticks in "
+         << wallSeconds << "s (" << (totalTicks > 0 ? wallSeconds * 1e6 / totalTicks : 0.0) << " us/tick)" << endl;
+    cout << "Total score: " << totalScore << ", "
+         << (mismatches == 0 ? "all runs match" : to_string(mismatches) + " runs diverged") << endl;
+
+    if (profileHeadless) {
+        cout << "Profile of the last " << min(totalTicks, static_cast<long long>(PROFILER_HISTORY_FRAMES))
+             << " ticks:" << endl;
+        Profiler::printSummary(cout);
+    }
+
+    setClock(&systemClock);
+    headless = false;
+    return mismatches == 0 ? 0 : 1;
+}
+
+bool Game::playReplayRun(const ReplayRun& run) {
+    const float deltaTime = 1.0f / tickRate;
+    nextRunIndex = run.runIndex;
+    state = GameState::PLAYING;
+    reset();
+
+    size_t next = 0;
+    for (Uint32 tick = 0; tick < run.ticks; ++tick) {
+        Profiler::beginFrame();
+        simulationClock.advance(deltaTime);
+        while (next < run.inputs.size() && run.inputs[next].tick == tick) {
+            pendingInput.push_back(run.inputs[next++].event);
+        }
+        update(deltaTime);
+        Profiler::endFrame();
+    }
+    return stateChecksum() == run.checksum;
+}
+
 void Game::init(SDL_Renderer* rend, TTF_Font* f) {
     renderer = rend;
     font = f;
+    textRenderer.init(renderer, font);
+    initializeHud();
 
     state = GameState::MENU;
     menuBackgroundTexture = nullptr;
@@ -205,39 +491,32 @@ void Game::init(SDL_Renderer* rend, TTF_Font* f) {
     screenShake = {false, 0.0f, 0, 0};
     healthRegenInfo = {false, 0, 0};
 
-    // Initialize resources
+    // Start decoding assets in the background; the loading screen uploads them
     ResourceManager::init(renderer);
-
-    playerTexture = ResourceManager::getTexture("assets/images/tank/player/tank_shoot_spritesheet.png");
-    enemyTexture = ResourceManager::getTexture("assets/images/tank/npc/enemy_tank.png");
-    shootSound = ResourceManager::getSound("assets/sounds/shoot.mp3");
-    rapidFireSound = ResourceManager::getSound("assets/sounds/rapid_fire.mp3");
-    explosionSound = ResourceManager::getSound("assets/sounds/explosion.mp3");
-    powerupSound = ResourceManager::getSound("assets/sounds/powerup.mp3");
-    shieldActivateSound = ResourceManager::getSound("assets/sounds/shield_activate.mp3");
-    shieldDeactivateSound = ResourceManager::getSound("assets/sounds/shield_deactivate.mp3");
-    healSound = ResourceManager::getSound("assets/sounds/heal.mp3");
-    backgroundMusic = ResourceManager::getMusic("assets/sounds/background_music.mp3");
-    buttonHoverSound = ResourceManager::getSound("assets/sounds/button_hover.mp3");
-
-
-    playerShieldTexture = ResourceManager::createRecoloredTexture(
-        "assets/images/tank/player/tank_shoot_spritesheet.png",
-        "assets/images/tank/player/tank_shield_spritesheet.png",
-        renderer,
-        100, 255, 100 // Green tint
-    );
+    state = GameState::LOADING;
+    assetsLoaded = false;
+    startAfterLoading = false;
+
+    playerTexture = ResourceManager::textureHandle(TextureId::PLAYER_TANK);
+    enemyTexture = ResourceManager::textureHandle(TextureId::ENEMY_TANK);
+    shootSound = ResourceManager::soundHandle(SoundId::SHOOT);
+    rapidFireSound = ResourceManager::soundHandle(SoundId::RAPID_FIRE);
+    explosionSound = ResourceManager::soundHandle(SoundId::EXPLOSION);
+    powerupSound = ResourceManager::soundHandle(SoundId::POWERUP);
+    shieldActivateSound = ResourceManager::soundHandle(SoundId::SHIELD_ACTIVATE);
+    shieldDeactivateSound = ResourceManager::soundHandle(SoundId::SHIELD_DEACTIVATE);
+    healSound = ResourceManager::soundHandle(SoundId::HEAL);
+    backgroundMusic = ResourceManager::musicHandle(MusicId::BACKGROUND);
+    buttonHoverSound = ResourceManager::soundHandle(SoundId::BUTTON_HOVER);
+    playerShieldTexture = ResourceManager::textureHandle(TextureId::PLAYER_SHIELD);
 
     player.texture = playerTexture;
     player.shieldTexture = playerShieldTexture;
-    player.isPlayer = true; 
 
     if (backgroundMusic) {
         Mix_PlayMusic(backgroundMusic, -1);
     }
 
-    initializeMenu();
-
     loadStatsFromFile();
     loadSettingsFromFile();
 
@@ -248,13 +527,12 @@ void Game::init(SDL_Renderer* rend, TTF_Font* f) {
         Mix_PauseMusic();
     }
     if (soundOn) {
-        Mix_Volume(-1, effectsVolume * 128 / 100);
+        VoiceManager::setVolume(effectsVolume * 128 / 100);
     } else {
-        Mix_Volume(-1, 0);
+        VoiceManager::setVolume(0);
     }
 
-    startGameSound = ResourceManager::getSound("assets/sounds/start_game.mp3");
-    if (!startGameSound) std::cout << "Khong load duoc sound" << std::endl;
+    startGameSound = ResourceManager::soundHandle(SoundId::START_GAME);
 }
 
 void Game::handleEvents(SDL_Event& e, bool& quit) {
@@ -262,14 +540,23 @@ void Game::handleEvents(SDL_Event& e, bool& quit) {
         quit = true;
     }
 
-    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE) {
-        if (state == GameState::PLAYING) {
-            state = GameState::PAUSED;
-            paused = true;
-        } else if (state == GameState::PAUSED) {
-            state = GameState::PLAYING;
-            paused = false;
-        }
+    // Render target contents are lost when the device is reset
+    if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+        hud.invalidate();
+    }
+
+    // F3: profiler overlay, F4: record the next frames as a Chrome trace
+    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3) {
+        Profiler::toggleOverlay();
+    }
+    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4) {
+        Profiler::startCapture("profile_trace.json");
+    }
+
+    // Pausing is part of the recorded input; it takes effect on the next tick
+    if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE &&
+        (state == GameState::PLAYING || state == GameState::PAUSED)) {
+        queueInput({InputType::PAUSE_TOGGLE, 0, 0.0f});
     }
 
     if (state == GameState::MENU) {
@@ -293,26 +580,50 @@ void Game::handleEvents(SDL_Event& e, bool& quit) {
 }
 
 void Game::update(float deltaTime) {
+    ProfileScope updateScope(ProfileZone::UPDATE);
+
+    // Also runs while paused so interpolation settles on the frozen state
+    storePreviousState();
+
+    if (state != GameState::PLAYING && state != GameState::PAUSED) {
+        return;
+    }
+
+    // Paused ticks count too: the clock keeps running through them
+    applyInputs();
+    runTick++;
+
     if (state != GameState::PLAYING || paused) {
         return;
     }
 
     gameTime += deltaTime;
 
-    player.update(deltaTime);
-    handleWallBounce(player);
-    handleRapidFire(deltaTime);
-    handleSpecialAbility(deltaTime);
+    Uint32 currentTime = clock->now();
+
+    {
+        ProfileScope scope(ProfileZone::PLAYER);
+        player.update(deltaTime, currentTime);
+        handleWallBounce(player);
+        handleRapidFire(deltaTime);
+        handleSpecialAbility(deltaTime);
+    }
 
     updateHealthRegenInfo(deltaTime);
 
     updateDifficulty();
 
-    Uint32 currentTime = SDL_GetTicks();
-    int maxEnemies = ENEMY_COUNT_MAX + (difficulty - 1);
-    if (currentTime - lastSpawnTime >= ENEMY_SPAWN_INTERVAL / difficulty && enemies.size() < maxEnemies) {
-        spawnEnemy();
-        lastSpawnTime = currentTime;
+    if (hordeMode) {
+        if (currentTime - lastSpawnTime >= HORDE_SPAWN_INTERVAL && enemies.size() < HORDE_ENEMY_MAX) {
+            spawnEnemies(min(HORDE_SPAWN_BATCH, HORDE_ENEMY_MAX - enemies.size()));
+            lastSpawnTime = currentTime;
+        }
+    } else {
+        int maxEnemies = ENEMY_COUNT_MAX + (difficulty - 1);
+        if (currentTime - lastSpawnTime >= ENEMY_SPAWN_INTERVAL / difficulty && enemies.size() < maxEnemies) {
+            spawnEnemies(1);
+            lastSpawnTime = currentTime;
+        }
     }
 
     if (currentTime - lastPowerUpTime >= 15000 && powerups.size() < 3) {
@@ -325,23 +636,27 @@ void Game::update(float deltaTime) {
         lastHealthPickupTime = currentTime;
     }
 
-    for (auto& enemy : enemies) {
-        if (enemy.alive) {
-            updateEnemyBehavior(enemy, deltaTime);
-            handleWallBounce(enemy);
-            enemyShoot(enemy);
-            enemy.update(deltaTime);
-        }
+    {
+        ProfileScope scope(ProfileZone::AI);
+        updateEnemies(deltaTime);
+    }
+
+    {
+        ProfileScope scope(ProfileZone::BULLETS);
+        bullets.update(deltaTime);
     }
 
-    for (auto& bullet : bullets) {
-        bullet.update(deltaTime);
+    {
+        ProfileScope scope(ProfileZone::PARTICLES);
+        particles.update(deltaTime);
     }
 
-    particles.update();
+    for (auto& explosion : explosions) {
+        explosion.update(currentTime);
+    }
 
     for (auto& notification : killNotifications) {
-        notification.update();
+        notification.update(currentTime);
     }
     killNotifications.erase(
         remove_if(killNotifications.begin(), killNotifications.end(),
@@ -349,9 +664,15 @@ void Game::update(float deltaTime) {
         killNotifications.end()
     );
 
-    handleCollisions();
+    {
+        ProfileScope scope(ProfileZone::COLLISIONS);
+        handleCollisions();
+    }
 
-    cleanup();
+    {
+        ProfileScope scope(ProfileZone::CLEANUP);
+        cleanup();
+    }
 
     updateCamera();
 
@@ -366,12 +687,12 @@ void Game::update(float deltaTime) {
 
         // Play shield deactivation sound
         if (shieldDeactivateSound) {
-            Mix_PlayChannel(-1, shieldDeactivateSound, 0);
+            VoiceManager::play(SoundId::SHIELD_DEACTIVATE, shieldDeactivateSound);
         }
 
         // Add shield deactivation particles
         SDL_Color shieldColor = {0, 255, 255, 255};
-        particles.emitCircle(player.x, player.y, SHIELD_RADIUS, 50, shieldColor, 60);
+        particles.emitCircle(player.x, player.y, SHIELD_RADIUS, 50, shieldColor, 1.0f);
     }
 
     // Update screen shake
@@ -385,42 +706,102 @@ void Game::update(float deltaTime) {
     if (!player.alive) {
         updateStatsAfterGameOver();
         state = GameState::GAME_OVER;
+        finishRun();
     }
 }
 
-void Game::render() {
+void Game::storePreviousState() {
+    player.storePreviousState();
+    enemies.storePreviousState();
+    bullets.storePreviousState();
+    prevCameraX = cameraX;
+    prevCameraY = cameraY;
+}
+
+void Game::render(GameState frameState) {
+    ProfileScope renderScope(ProfileZone::RENDER);
+
     SDL_SetRenderDrawColor(renderer, 20, 20, 20, 255); // Darker background
     SDL_RenderClear(renderer);
 
-    if (state == GameState::MENU) {
+    // The world comes from the newest snapshot, never the live simulation;
+    // menus only read state this thread owns
+    if (frameState == GameState::LOADING) {
+        renderLoadingScreen();
+    } else if (frameState == GameState::MENU) {
         renderMenu();
-    } else if (state == GameState::PLAYING || state == GameState::PAUSED) {
-        renderGame();
-        if (state == GameState::PAUSED) {
+    } else if (frameState == GameState::PLAYING || frameState == GameState::PAUSED) {
+        WorldSnapshot& world = snapshots.acquire();
+        renderAlpha = world.alphaAt(SDL_GetPerformanceCounter());
+        renderGame(world);
+        if (frameState == GameState::PAUSED) {
             renderPauseMenu();
         }
-    } else if (state == GameState::GAME_OVER) {
-        renderGame();
-        renderGameOver();
-    } else if (state == GameState::TUTORIAL_SCREEN) {
+    } else if (frameState == GameState::GAME_OVER) {
+        WorldSnapshot& world = snapshots.acquire();
+        renderAlpha = world.alphaAt(SDL_GetPerformanceCounter());
+        renderGame(world);
+        renderGameOver(world);
+    } else if (frameState == GameState::TUTORIAL_SCREEN) {
         renderTutorialScreen();
-    } else if (state == GameState::SETTINGS_SCREEN) {
+    } else if (frameState == GameState::SETTINGS_SCREEN) {
         renderSettingsScreen();
-    } else if (state == GameState::STATS_SCREEN) {
+    } else if (frameState == GameState::STATS_SCREEN) {
         renderStatsScreen();
     }
 
+    if (Profiler::isOverlayVisible()) {
+        Profiler::renderOverlay(renderer, textRenderer);
+    }
+
+    ProfileScope presentScope(ProfileZone::PRESENT);
     SDL_RenderPresent(renderer);
 }
 
+void Game::updateHeadlessPlayer() {
+    // Simple autopilot so headless runs exercise shooting and collisions:
+    // aim at the closest enemy and fire at a human-like rate.
+    if (!player.alive) {
+        return;
+    }
+
+    int target = -1;
+    float bestDistance = 0.0f;
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (!enemies.isAlive(i)) {
+            continue;
+        }
+        float dx = enemies.x[i] - player.x;
+        float dy = enemies.y[i] - player.y;
+        float distance = dx * dx + dy * dy;
+        if (target < 0 || distance < bestDistance) {
+            target = i;
+            bestDistance = distance;
+        }
+    }
+
+    if (target < 0) {
+        return;
+    }
+
+    // Goes through the same input queue as a human, so --record captures it
+    queueInput({InputType::AIM, 0, atan2(enemies.y[target] - player.y, enemies.x[target] - player.x)});
+
+    Uint32 currentTime = clock->now();
+    if (currentTime - lastHeadlessShotTime >= 250) {
+        queueInput({InputType::BUTTON_DOWN, INPUT_BUTTON_LEFT, 0.0f});
+        queueInput({InputType::BUTTON_UP, INPUT_BUTTON_LEFT, 0.0f});
+        lastHeadlessShotTime = currentTime;
+    }
+}
+
 void Game::handleSpecialAbility(float deltaTime) {
     if (!player.alive || state != GameState::PLAYING) {
         return;
     }
 
     // Check for cancel with 'A' key
-    const Uint8* keyState = SDL_GetKeyboardState(NULL);
-    if (player.isSpecialActive && keyState[SDL_SCANCODE_A]) {
+    if (player.isSpecialActive && keyAHeld) {
         // Cancel special ability
         player.isSpecialActive = false;
         player.specialActivationTimer = 0;
@@ -447,21 +828,19 @@ void Game::handleSpecialAbility(float deltaTime) {
             float bulletX, bulletY;
             player.getBulletSpawnPosition(bulletX, bulletY);
 
-            Bullet bullet(
+            bullets.spawn(
                 bulletX, bulletY,
                 BULLET_SPEED * 1.5f * cos(player.angle),
                 BULLET_SPEED * 1.5f * sin(player.angle),
                 false,
-                1000, 
+                1000,
                 true
-            ); 
-
-            bullets.push_back(bullet);
+            );
             player.specialBullets--;
 
             // Play special sound
             if (shootSound) {
-                Mix_PlayChannel(-1, shootSound, 0);
+                VoiceManager::play(SoundId::SHOOT, shootSound);
             }
 
             // Add special muzzle flash particles
@@ -485,22 +864,23 @@ void Game::handleSpecialAbility(float deltaTime) {
     }
 }
 
-void Game::renderSpecialTargetingLine() {
-    if (!player.isSpecialActive) {
+void Game::renderSpecialTargetingLine(const Tank& tank, float viewX, float viewY) {
+    if (!tank.isSpecialActive) {
         return;
     }
 
-    float lineProgress = min(player.specialActivationTimer / 3.0f, 1.0f);
+    float lineProgress = min(tank.specialActivationTimer / 3.0f, 1.0f);
     int lineLength = static_cast<int>(SPECIAL_LINE_LENGTH * lineProgress);
 
-    float bulletX, bulletY;
-    player.getBulletSpawnPosition(bulletX, bulletY);
+    // Start from the interpolated tank so the line stays attached to the sprite
+    float bulletX = tank.renderX(renderAlpha) + tank.collisionRadius * cos(tank.angle);
+    float bulletY = tank.renderY(renderAlpha) + tank.collisionRadius * sin(tank.angle);
 
-    int startX = static_cast<int>(bulletX - cameraX);
-    int startY = static_cast<int>(bulletY - cameraY);
+    int startX = static_cast<int>(bulletX - viewX);
+    int startY = static_cast<int>(bulletY - viewY);
 
-    int endX = startX + static_cast<int>(cos(player.angle) * lineLength);
-    int endY = startY + static_cast<int>(sin(player.angle) * lineLength);
+    int endX = startX + static_cast<int>(cos(tank.angle) * lineLength);
+    int endY = startY + static_cast<int>(sin(tank.angle) * lineLength);
 
     // Draw line
     SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255); // Purple for special
@@ -509,8 +889,8 @@ void Game::renderSpecialTargetingLine() {
     // Draw small circles along the line for better visibility
     int numCircles = static_cast<int>(lineLength / 50);
     for (int i = 0; i < numCircles; i++) {
-        int circleX = startX + static_cast<int>(cos(player.angle) * i * 50);
-        int circleY = startY + static_cast<int>(sin(player.angle) * i * 50);
+        int circleX = startX + static_cast<int>(cos(tank.angle) * i * 50);
+        int circleY = startY + static_cast<int>(sin(tank.angle) * i * 50);
 
         SDL_Rect circleRect = {circleX - 2, circleY - 2, 4, 4};
         SDL_RenderFillRect(renderer, &circleRect);
@@ -536,7 +916,7 @@ void Game::handleMenuEvents(SDL_Event& e) {
             if (!wasHovered && button.isHovered) {
                 // Play hover sound
                 if (buttonHoverSound) {
-                    Mix_PlayChannel(-1, buttonHoverSound, 0);
+                    VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
                 }
                 // Set target scale for grow animation
                 buttonAnimations[button.type].targetScale = 1.2f;
@@ -556,7 +936,13 @@ void Game::handleMenuEvents(SDL_Event& e) {
                 mouseY <= button.rect.y + button.rect.h) {
                 switch (button.type) {
                     case MenuButton::START:
-                        if (startGameSound) Mix_PlayChannel(-1, startGameSound, 0);
+                        if (startGameSound) VoiceManager::play(SoundId::START_GAME, startGameSound);
+                        if (!assetsLoaded) {
+                            // Finish loading behind the progress screen, then start
+                            state = GameState::LOADING;
+                            startAfterLoading = true;
+                            break;
+                        }
                         state = GameState::PLAYING;
                         reset();
                         break;
@@ -599,24 +985,25 @@ void Game::handlePauseEvents(SDL_Event& e) {
     hoverPauseMenu = (mouseX >= menuButton.x && mouseX <= menuButton.x + BUTTON_WIDTH &&
                       mouseY >= menuButton.y && mouseY <= menuButton.y + BUTTON_HEIGHT);
     if (hoverPauseResume != prevHoverPauseResume && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     if (hoverPauseMenu != prevHoverPauseMenu && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     prevHoverPauseResume = hoverPauseResume;
     prevHoverPauseMenu = hoverPauseMenu;
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
         if (hoverPauseResume) {
-            state = GameState::PLAYING;
-            paused = false;
+            queueInput({InputType::PAUSE_TOGGLE, 0, 0.0f});
         } else if (hoverPauseMenu) {
+            finishRun();
             state = GameState::MENU;
         }
     }
 }
 
 void Game::handleGameEvents(SDL_Event& e) {
+    // Only translate here; the simulation changes in applyInput at the next tick
     if (e.type == SDL_MOUSEMOTION) {
         int mouseX, mouseY;
         SDL_GetMouseState(&mouseX, &mouseY);
@@ -626,68 +1013,182 @@ void Game::handleGameEvents(SDL_Event& e) {
             float dx = worldX - player.x;
             float dy = worldY - player.y;
             if (dx != 0 || dy != 0) {
-                player.angle = atan2(dy, dx);
-            }
-        }
-    } else if (e.type == SDL_MOUSEBUTTONDOWN) {
-        if (e.button.button == SDL_BUTTON_LEFT) {
-            mouseHeld = true;
-            if (!rapidFire.active) {
-                shoot();
+                queueInput({InputType::AIM, 0, atan2(dy, dx)});
             }
-        } else if (e.button.button == SDL_BUTTON_RIGHT && player.specialBullets > 0) {
-            rightMouseHeld = true;
         }
-    } else if (e.type == SDL_MOUSEBUTTONUP) {
+    } else if (e.type == SDL_MOUSEBUTTONDOWN || e.type == SDL_MOUSEBUTTONUP) {
+        InputType type = e.type == SDL_MOUSEBUTTONDOWN ? InputType::BUTTON_DOWN : InputType::BUTTON_UP;
         if (e.button.button == SDL_BUTTON_LEFT) {
-            mouseHeld = false;
+            queueInput({type, INPUT_BUTTON_LEFT, 0.0f});
         } else if (e.button.button == SDL_BUTTON_RIGHT) {
-            rightMouseHeld = false;
-        }
-    } else if (e.type == SDL_KEYDOWN) {
-        // Movement with WASD
-        if (e.key.keysym.sym == SDLK_w) {
-            player.vy = -player.speed * 2.0f;
-        } else if (e.key.keysym.sym == SDLK_s) {
-            player.vy = player.speed * 2.0f;
-        } else if (e.key.keysym.sym == SDLK_a) {
-            player.vx = -player.speed * 2.0f;
-
-            // If 'A' is pressed while special ability is active, it will be handled in handleSpecialAbility
-        } else if (e.key.keysym.sym == SDLK_d) {
-            player.vx = player.speed * 2.0f;
-        } else if (e.key.keysym.sym == SDLK_e && shieldCooldownRemaining == 0) {
-            // Shield ability
-            activateShield();
-        } else if (e.key.keysym.sym == SDLK_q && rapidFire.cooldownRemaining == 0) {
-            // Rapid fire ability
-            rapidFire.active = true;
-            rapidFire.startTime = SDL_GetTicks();
-            rapidFire.lastShotTime = 0;
-            rapidFire.lastActivationTime = rapidFire.startTime;
-            rapidFire.cooldownRemaining = RAPID_FIRE_COOLDOWN;
-        } else if (e.key.keysym.sym == SDLK_t) {
-            // Use health pickup
-            cout << "S key pressed. Health packs: " << player.healthPickups << endl;
-            if (player.healthPickups > 0) {
-                useHealthPickup();
-                cout << "Used health pack. New HP: " << player.hp << "/" << player.maxHp << endl;
-            }
+            queueInput({type, INPUT_BUTTON_RIGHT, 0.0f});
         }
-    } else if (e.type == SDL_KEYUP) {
-        // Stop movement when keys are released
-        if (e.key.keysym.sym == SDLK_w && player.vy < 0) {
-            player.vy = 0;
-        } else if (e.key.keysym.sym == SDLK_s && player.vy > 0) {
-            player.vy = 0;
-        } else if (e.key.keysym.sym == SDLK_a && player.vx < 0) {
-            player.vx = 0;
-        } else if (e.key.keysym.sym == SDLK_d && player.vx > 0) {
-            player.vx = 0;
+    } else if (e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) {
+        static const unordered_map<SDL_Keycode, InputKey> keys = {
+            {SDLK_w, INPUT_KEY_W}, {SDLK_a, INPUT_KEY_A}, {SDLK_s, INPUT_KEY_S}, {SDLK_d, INPUT_KEY_D},
+            {SDLK_e, INPUT_KEY_E}, {SDLK_q, INPUT_KEY_Q}, {SDLK_t, INPUT_KEY_T}
+        };
+        auto key = keys.find(e.key.keysym.sym);
+        if (key != keys.end()) {
+            InputType type = e.type == SDL_KEYDOWN ? InputType::KEY_DOWN : InputType::KEY_UP;
+            queueInput({type, key->second, 0.0f});
         }
     }
 }
 
+void Game::queueInput(const InputEvent& input) {
+    // Only the last aim of a tick matters
+    if (input.type == InputType::AIM && !pendingInput.empty() && pendingInput.back().type == InputType::AIM) {
+        pendingInput.back() = input;
+        return;
+    }
+    pendingInput.push_back(input);
+}
+
+void Game::applyInputs() {
+    for (const InputEvent& input : pendingInput) {
+        // While paused only unpausing does anything, as before
+        if (paused && input.type != InputType::PAUSE_TOGGLE) {
+            continue;
+        }
+        // Aiming where the turret already points changes nothing; keep it out of the file
+        if (input.type == InputType::AIM && input.angle == player.angle) {
+            continue;
+        }
+        if (recordingRun) {
+            recording.runs.back().inputs.push_back({runTick, input});
+        }
+        applyInput(input);
+    }
+    pendingInput.clear();
+}
+
+void Game::applyInput(const InputEvent& input) {
+    switch (input.type) {
+        case InputType::AIM:
+            player.angle = input.angle;
+            break;
+
+        case InputType::BUTTON_DOWN:
+            if (input.code == INPUT_BUTTON_LEFT) {
+                mouseHeld = true;
+                if (!rapidFire.active) {
+                    shoot();
+                }
+            } else if (input.code == INPUT_BUTTON_RIGHT && player.specialBullets > 0) {
+                rightMouseHeld = true;
+            }
+            break;
+
+        case InputType::BUTTON_UP:
+            if (input.code == INPUT_BUTTON_LEFT) {
+                mouseHeld = false;
+            } else if (input.code == INPUT_BUTTON_RIGHT) {
+                rightMouseHeld = false;
+            }
+            break;
+
+        case InputType::KEY_DOWN:
+            // Movement with WASD
+            if (input.code == INPUT_KEY_W) {
+                player.vy = -player.speed * 2.0f;
+            } else if (input.code == INPUT_KEY_S) {
+                player.vy = player.speed * 2.0f;
+            } else if (input.code == INPUT_KEY_A) {
+                player.vx = -player.speed * 2.0f;
+
+                // If 'A' is pressed while special ability is active, it will be handled in handleSpecialAbility
+                keyAHeld = true;
+            } else if (input.code == INPUT_KEY_D) {
+                player.vx = player.speed * 2.0f;
+            } else if (input.code == INPUT_KEY_E && shieldCooldownRemaining == 0) {
+                // Shield ability
+                activateShield();
+            } else if (input.code == INPUT_KEY_Q && rapidFire.cooldownRemaining == 0) {
+                // Rapid fire ability
+                rapidFire.active = true;
+                rapidFire.startTime = clock->now();
+                rapidFire.lastShotTime = 0;
+                rapidFire.lastActivationTime = rapidFire.startTime;
+                rapidFire.cooldownRemaining = RAPID_FIRE_COOLDOWN;
+            } else if (input.code == INPUT_KEY_T) {
+                // Use health pickup
+                cout << "S key pressed. Health packs: " << player.healthPickups << endl;
+                if (player.healthPickups > 0) {
+                    useHealthPickup();
+                    cout << "Used health pack. New HP: " << player.hp << "/" << player.maxHp << endl;
+                }
+            }
+            break;
+
+        case InputType::KEY_UP:
+            // Stop movement when keys are released
+            if (input.code == INPUT_KEY_W && player.vy < 0) {
+                player.vy = 0;
+            } else if (input.code == INPUT_KEY_S && player.vy > 0) {
+                player.vy = 0;
+            } else if (input.code == INPUT_KEY_A) {
+                keyAHeld = false;
+                if (player.vx < 0) {
+                    player.vx = 0;
+                }
+            } else if (input.code == INPUT_KEY_D && player.vx > 0) {
+                player.vx = 0;
+            }
+            break;
+
+        case InputType::PAUSE_TOGGLE:
+            if (state == GameState::PLAYING) {
+                state = GameState::PAUSED;
+                paused = true;
+            } else if (state == GameState::PAUSED) {
+                state = GameState::PLAYING;
+                paused = false;
+            }
+            break;
+    }
+}
+
+void Game::finishRun() {
+    if (!recordingRun) {
+        return;
+    }
+    recordingRun = false;
+
+    ReplayRun& run = recording.runs.back();
+    run.ticks = runTick;
+    run.checksum = stateChecksum();
+    // Rewritten after every run so a crash loses at most the current one
+    recording.save(recordPath);
+}
+
+Uint32 Game::stateChecksum() const {
+    // FNV-1a over the state a diverging replay would disturb first
+    Uint32 hash = 2166136261u;
+    auto mix = [&hash](const void* data, size_t size) {
+        const Uint8* bytes = static_cast<const Uint8*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    };
+
+    mix(&runTick, sizeof(runTick));
+    mix(&stats.score, sizeof(stats.score));
+    mix(&stats.tanksDestroyed, sizeof(stats.tanksDestroyed));
+    mix(&player.hp, sizeof(player.hp));
+    mix(&player.x, sizeof(player.x));
+    mix(&player.y, sizeof(player.y));
+    mix(&player.angle, sizeof(player.angle));
+    for (int i = 0; i < enemies.size(); ++i) {
+        mix(&enemies.x[i], sizeof(float));
+        mix(&enemies.y[i], sizeof(float));
+        mix(&enemies.hp[i], sizeof(int));
+    }
+    int bulletCount = bullets.size();
+    mix(&bulletCount, sizeof(bulletCount));
+    return hash;
+}
+
 void Game::useHealthPickup() {
     if (player.healthPickups <= 0 || player.hp >= player.maxHp) {
         return;
@@ -709,21 +1210,21 @@ void Game::useHealthPickup() {
 
     // Play heal sound
     if (healSound) {
-        Mix_PlayChannel(-1, healSound, 0);
+        VoiceManager::play(SoundId::HEAL, healSound);
     }
 
     // Add healing particles
     SDL_Color healColor = {0, 255, 0, 255};
-    particles.emitCircle(player.x, player.y, 40, 30, healColor, 60);
+    particles.emitCircle(player.x, player.y, 40, 30, healColor, 1.0f);
 
     // Add notification
-    killNotifications.push_back(KillNotification("HEALTH +" + to_string(healAmount)));
+    killNotifications.push_back(KillNotification("HEALTH +" + to_string(healAmount), clock->now()));
 
     cout << "Used health pack. Healed: " << healAmount << " New HP: " << player.hp << "/" << player.maxHp << endl;
 }
 
 void Game::activateShield() {
-    shieldStartTime = SDL_GetTicks();
+    shieldStartTime = clock->now();
     lastShieldTime = shieldStartTime;
     shieldCooldownRemaining = SHIELD_COOLDOWN;
 
@@ -734,18 +1235,18 @@ void Game::activateShield() {
 
     // Play shield activation sound
     if (shieldActivateSound) {
-        Mix_PlayChannel(-1, shieldActivateSound, 0);
+        VoiceManager::play(SoundId::SHIELD_ACTIVATE, shieldActivateSound);
     }
 
     // Add shield activation particles
     SDL_Color shieldColor = {0, 255, 255, 255};
-    particles.emitCircle(player.x, player.y, SHIELD_RADIUS, 50, shieldColor, 60);
+    particles.emitCircle(player.x, player.y, SHIELD_RADIUS, 50, shieldColor, 1.0f);
 }
 
 void Game::activateScreenShake(float intensity, Uint32 duration) {
     screenShake.active = true;
     screenShake.intensity = intensity;
-    screenShake.startTime = SDL_GetTicks();
+    screenShake.startTime = clock->now();
     screenShake.duration = duration;
 }
 
@@ -760,17 +1261,15 @@ void Game::updateCamera() {
     // Target camera position (centered on player)
     float targetCameraX = player.x - (WINDOW_WIDTH / currentCameraZoom) / 2.0f;
     float targetCameraY = player.y - (WINDOW_HEIGHT / currentCameraZoom) / 2.0f;
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
-
     // Apply screen shake if active
     if (screenShake.active) {
-        Uint32 currentTime = SDL_GetTicks();
+        Uint32 currentTime = clock->now();
         float progress = (currentTime - screenShake.startTime) / static_cast<float>(screenShake.duration);
         float intensity = screenShake.intensity * (1.0f - progress);
 
-        uniform_real_distribution<float> shakeDist(-1.0f, 1.0f);
-        targetCameraX += shakeDist(rng) * intensity;
-        targetCameraY += shakeDist(rng) * intensity;
+        Rng& rng = random.stream(RngStream::CAMERA);
+        targetCameraX += rng.uniform(-1.0f, 1.0f) * intensity;
+        targetCameraY += rng.uniform(-1.0f, 1.0f) * intensity;
     }
 
     // Clamp camera to map bounds
@@ -789,38 +1288,44 @@ void Game::updateDifficulty() {
     }
 }
 
-void Game::handleWallBounce(Tank& tank) {
-    if (!tank.alive) return;
+bool Game::bounceOffWalls(float& x, float& y, float& vx, float& vy, float radius) {
     float borderLeft = static_cast<float>(BORDER_OFFSET);
     float borderRight = static_cast<float>(MAP_WIDTH - BORDER_OFFSET);
     float borderTop = static_cast<float>(BORDER_OFFSET);
     float borderBottom = static_cast<float>(MAP_HEIGHT - BORDER_OFFSET);
     bool bounced = false;
 
-    if (tank.x <= borderLeft + tank.collisionRadius) {
-        tank.vx = abs(tank.vx) * BOUNCE_FACTOR;
-        tank.x = borderLeft + tank.collisionRadius;
+    if (x <= borderLeft + radius) {
+        vx = abs(vx) * BOUNCE_FACTOR;
+        x = borderLeft + radius;
         bounced = true;
-    } else if (tank.x >= borderRight - tank.collisionRadius) {
-        tank.vx = -abs(tank.vx) * BOUNCE_FACTOR;
-        tank.x = borderRight - tank.collisionRadius;
+    } else if (x >= borderRight - radius) {
+        vx = -abs(vx) * BOUNCE_FACTOR;
+        x = borderRight - radius;
         bounced = true;
     }
 
-    if (tank.y <= borderTop + tank.collisionRadius) {
-        tank.vy = abs(tank.vy) * BOUNCE_FACTOR;
-        tank.y = borderTop + tank.collisionRadius;
+    if (y <= borderTop + radius) {
+        vy = abs(vy) * BOUNCE_FACTOR;
+        y = borderTop + radius;
         bounced = true;
-    } else if (tank.y >= borderBottom - tank.collisionRadius) {
-        tank.vy = -abs(tank.vy) * BOUNCE_FACTOR;
-        tank.y = borderBottom - tank.collisionRadius;
+    } else if (y >= borderBottom - radius) {
+        vy = -abs(vy) * BOUNCE_FACTOR;
+        y = borderBottom - radius;
         bounced = true;
     }
 
     if (bounced) {
-        tank.x = max(borderLeft + tank.collisionRadius, min(tank.x, borderRight - tank.collisionRadius));
-        tank.y = max(borderTop + tank.collisionRadius, min(tank.y, borderBottom - tank.collisionRadius));
+        x = max(borderLeft + radius, min(x, borderRight - radius));
+        y = max(borderTop + radius, min(y, borderBottom - radius));
+    }
+    return bounced;
+}
+
+void Game::handleWallBounce(Tank& tank) {
+    if (!tank.alive) return;
 
+    if (bounceOffWalls(tank.x, tank.y, tank.vx, tank.vy, tank.collisionRadius)) {
         // Add bounce particles
         SDL_Color color = {200, 200, 200, 255};
         particles.emit(tank.x, tank.y, atan2(tank.vy, tank.vx) + M_PI, 10, color);
@@ -832,29 +1337,38 @@ void Game::handleWallBounce(Tank& tank) {
     }
 }
 
+void Game::handleEnemyWallBounce(int enemy, CommandBuffer& commands) {
+    if (!enemies.isAlive(enemy)) return;
+
+    if (bounceOffWalls(enemies.x[enemy], enemies.y[enemy], enemies.vx[enemy], enemies.vy[enemy], enemies.radius[enemy])) {
+        SDL_Color color = {200, 200, 200, 255};
+        commands.emitParticles(enemies.x[enemy], enemies.y[enemy], atan2(enemies.vy[enemy], enemies.vx[enemy]) + M_PI,
+                               10, color);
+    }
+}
+
 void Game::shoot() {
     float bulletX, bulletY;
     player.getBulletSpawnPosition(bulletX, bulletY);
 
-    Bullet bullet(
+    bullets.spawn(
         bulletX, bulletY,
         BULLET_SPEED * cos(player.angle),
         BULLET_SPEED * sin(player.angle),
         false,
         player.damage
     );
-    bullets.push_back(bullet);
     stats.bulletsFired++;
     player.vx -= RECOIL_FORCE * cos(player.angle);
     player.vy -= RECOIL_FORCE * sin(player.angle);
 
     if (shootSound) {
-        Mix_PlayChannel(-1, shootSound, 0);
+        VoiceManager::play(SoundId::SHOOT, shootSound);
     }
 
     player.isShooting = true;
     player.currentFrame = 0;
-    player.lastFrameTime = SDL_GetTicks();
+    player.lastFrameTime = clock->now();
 
     // Add muzzle flash particles
     SDL_Color color = {255, 200, 0, 255};
@@ -876,37 +1390,36 @@ void Game::shoot() {
 
             // Notification effect for earning special bullet
             SDL_Color specialColor = {255, 0, 255, 255};
-            particles.emitCircle(player.x, player.y, 50, 30, specialColor, 60);
+            particles.emitCircle(player.x, player.y, 50, 30, specialColor, 1.0f);
 
             // Play special sound if available
             if (powerupSound) {
-                Mix_PlayChannel(-1, powerupSound, 0);
+                VoiceManager::play(SoundId::POWERUP, powerupSound);
             }
         }
     }
 }
 
 void Game::handleRapidFire(float deltaTime) {
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = clock->now();
     if (rapidFire.active && currentTime - rapidFire.startTime < RAPID_FIRE_DURATION) {
         if (mouseHeld && currentTime - rapidFire.lastShotTime >= RAPID_FIRE_INTERVAL) {
             float bulletX, bulletY;
             player.getBulletSpawnPosition(bulletX, bulletY);
 
-            Bullet bullet(
+            bullets.spawn(
                 bulletX, bulletY,
                 BULLET_SPEED * cos(player.angle),
                 BULLET_SPEED * sin(player.angle),
                 false,
                 player.damage
             );
-            bullets.push_back(bullet);
             stats.bulletsFired++;
             player.vx -= RECOIL_FORCE * cos(player.angle) * 0.5f; // Reduced recoil for rapid fire
             player.vy -= RECOIL_FORCE * sin(player.angle) * 0.5f;
 
             if (rapidFireSound) {
-                Mix_PlayChannel(-1, rapidFireSound, 0);
+                VoiceManager::play(SoundId::RAPID_FIRE, rapidFireSound);
             }
 
             player.isShooting = true;
@@ -937,6 +1450,15 @@ void Game::handleRapidFire(float deltaTime) {
     }
 }
 
+void Game::spawnEnemies(int count) {
+    // One grid rebuild per wave; tanks spawned since then are checked directly
+    rebuildEnemyGrid();
+    spawnBatchStart = enemies.size();
+    for (int i = 0; i < count; ++i) {
+        spawnEnemy();
+    }
+}
+
 void Game::spawnEnemy() {
     // Get current view boundaries
     float viewLeft = cameraX;
@@ -944,52 +1466,56 @@ void Game::spawnEnemy() {
     float viewTop = cameraY;
     float viewBottom = cameraY + WINDOW_HEIGHT;
 
-    // Keep track of last spawn edge
-    static int lastSpawnEdge = -1;
-    
     // Select spawn edge (0: top, 1: right, 2: bottom, 3: left)
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
-    vector<int> availableEdges = {0, 1, 2, 3};
-    
-    // Remove last used edge from available edges
-    if (lastSpawnEdge >= 0) {
-        availableEdges.erase(remove(availableEdges.begin(), availableEdges.end(), lastSpawnEdge), availableEdges.end());
+    Rng& rng = random.stream(RngStream::SPAWN);
+    int availableEdges[4];
+    int edgeCount = 0;
+
+    // Skip the last used edge
+    for (int edge = 0; edge < 4; ++edge) {
+        if (edge != lastSpawnEdge) {
+            availableEdges[edgeCount++] = edge;
+        }
     }
-    
+
     // Randomly select from available edges
-    uniform_int_distribution<int> edgeDist(0, availableEdges.size() - 1);
-    int selectedEdge = availableEdges[edgeDist(rng)];
+    int selectedEdge = availableEdges[rng.uniformInt(0, edgeCount - 1)];
     lastSpawnEdge = selectedEdge;
 
     float x, y;
     // Generate spawn position based on selected edge
     switch (selectedEdge) {
         case 0: // Top edge
-            x = BORDER_OFFSET + rand() % (MAP_WIDTH - 2 * BORDER_OFFSET);
+            x = BORDER_OFFSET + rng.uniformInt(0, MAP_WIDTH - 2 * BORDER_OFFSET - 1);
             y = BORDER_OFFSET - 30.0f;
             break;
         case 1: // Right edge
             x = MAP_WIDTH - BORDER_OFFSET + 30.0f;
-            y = BORDER_OFFSET + rand() % (MAP_HEIGHT - 2 * BORDER_OFFSET);
+            y = BORDER_OFFSET + rng.uniformInt(0, MAP_HEIGHT - 2 * BORDER_OFFSET - 1);
             break;
         case 2: // Bottom edge
-            x = BORDER_OFFSET + rand() % (MAP_WIDTH - 2 * BORDER_OFFSET);
+            x = BORDER_OFFSET + rng.uniformInt(0, MAP_WIDTH - 2 * BORDER_OFFSET - 1);
             y = MAP_HEIGHT - BORDER_OFFSET + 30.0f;
             break;
         case 3: // Left edge
             x = BORDER_OFFSET - 30.0f;
-            y = BORDER_OFFSET + rand() % (MAP_HEIGHT - 2 * BORDER_OFFSET);
+            y = BORDER_OFFSET + rng.uniformInt(0, MAP_HEIGHT - 2 * BORDER_OFFSET - 1);
             break;
     }
 
-    // Check if spawn position is too close to other enemies
+    // Check if spawn position is too close to other enemies. A horde
+    // arrives packed: spaced out like this the map only fits a few hundred.
+    const float minSpawnDistance = hordeMode ? 0.0f : 100.0f;
     bool tooClose = false;
-    for (const auto& enemy : enemies) {
-        if (enemy.alive) {
-            float dx = x - enemy.x;
-            float dy = y - enemy.y;
-            float distance = sqrt(dx * dx + dy * dy);
-            if (distance < 100.0f) { // Minimum distance between enemies
+    enemyGrid.query(x, y, minSpawnDistance, nearbyItems);
+    for (int i = spawnBatchStart; i < enemies.size(); ++i) {
+        nearbyItems.push_back(i);
+    }
+    for (int index : nearbyItems) {
+        if (enemies.isAlive(index)) {
+            float dx = x - enemies.x[index];
+            float dy = y - enemies.y[index];
+            if (dx * dx + dy * dy < minSpawnDistance * minSpawnDistance) {
                 tooClose = true;
                 break;
             }
@@ -1002,8 +1528,7 @@ void Game::spawnEnemy() {
     }
 
     // Randomly choose enemy type based on difficulty
-    uniform_int_distribution<int> typeDist(0, 99);
-    int roll = typeDist(rng);
+    int roll = rng.uniformInt(0, 99);
     EnemyType enemyType;
 
     if (difficulty >= 3 && roll < 20) {
@@ -1014,76 +1539,134 @@ void Game::spawnEnemy() {
         enemyType = EnemyType::BASIC;
     }
 
-    Tank enemy(x, y, enemyTexture, enemyType);
-    enemies.push_back(enemy);
+    enemies.spawn(x, y, enemyType);
 }
 
 void Game::spawnPowerUp() {
     // Random position within the map bounds
-    uniform_int_distribution<int> xDist(BORDER_OFFSET + 50, MAP_WIDTH - BORDER_OFFSET - 50);
-    uniform_int_distribution<int> yDist(BORDER_OFFSET + 50, MAP_HEIGHT - BORDER_OFFSET - 50);
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
-    float x = static_cast<float>(xDist(rng));
-    float y = static_cast<float>(yDist(rng));
+    Rng& rng = random.stream(RngStream::SPAWN);
+    float x = static_cast<float>(rng.uniformInt(BORDER_OFFSET + 50, MAP_WIDTH - BORDER_OFFSET - 50));
+    float y = static_cast<float>(rng.uniformInt(BORDER_OFFSET + 50, MAP_HEIGHT - BORDER_OFFSET - 50));
 
     // Random power-up type
-    uniform_int_distribution<int> typeDist(0, 4);
-    PowerUpType type = static_cast<PowerUpType>(typeDist(rng));
+    PowerUpType type = static_cast<PowerUpType>(rng.uniformInt(0, 4));
 
-    PowerUp powerup(x, y, type);
+    PowerUp powerup(x, y, type, clock->now());
     powerups.push_back(powerup);
 
-    lastPowerUpTime = SDL_GetTicks();
+    lastPowerUpTime = clock->now();
 }
 
 void Game::spawnHealthPickup() {
     // Random position within the map bounds
-    uniform_int_distribution<int> xDist(BORDER_OFFSET + 50, MAP_WIDTH - BORDER_OFFSET - 50);
-    uniform_int_distribution<int> yDist(BORDER_OFFSET + 50, MAP_HEIGHT - BORDER_OFFSET - 50);
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
-    float x = static_cast<float>(xDist(rng));
-    float y = static_cast<float>(yDist(rng));
+    Rng& rng = random.stream(RngStream::SPAWN);
+    float x = static_cast<float>(rng.uniformInt(BORDER_OFFSET + 50, MAP_WIDTH - BORDER_OFFSET - 50));
+    float y = static_cast<float>(rng.uniformInt(BORDER_OFFSET + 50, MAP_HEIGHT - BORDER_OFFSET - 50));
 
-    PowerUp healthPickup(x, y, PowerUpType::HEALTH_PICKUP);
+    PowerUp healthPickup(x, y, PowerUpType::HEALTH_PICKUP, clock->now());
     powerups.push_back(healthPickup);
 
-    lastHealthPickupTime = SDL_GetTicks();
+    lastHealthPickupTime = clock->now();
+}
+
+void Game::updateEnemies(float deltaTime) {
+    drawSteerJitter(deltaTime);
+
+    int batches = JobSystem::batchCount(enemies.size(), ENEMY_JOB_BATCH);
+    if (static_cast<int>(enemyCommands.size()) < batches) {
+        enemyCommands.resize(batches);
+    }
+
+    // Each enemy only writes its own fields and reads the player; bullets and
+    // particles wait in the batch's buffer
+    JobSystem::parallelFor(enemies.size(), ENEMY_JOB_BATCH, [&](int begin, int end, int batch) {
+        CommandBuffer& commands = enemyCommands[batch];
+        commands.clear();
+        for (int i = begin; i < end; ++i) {
+            if (enemies.isAlive(i)) {
+                updateEnemyBehavior(i, deltaTime);
+                handleEnemyWallBounce(i, commands);
+                enemyShoot(i, commands);
+            }
+        }
+        enemies.update(deltaTime, begin, end);
+    });
+
+    // Batches cover the enemies in order, so this matches a serial loop
+    for (int batch = 0; batch < batches; ++batch) {
+        enemyCommands[batch].apply(bullets, particles);
+    }
+}
+
+void Game::drawSteerJitter(float deltaTime) {
+    steerJitter.assign(enemies.size(), {false, 0.0f, 0.0f});
+    if (!player.alive) {
+        return;
+    }
+
+    // The shared counter and AI stream are used in enemy order here, so the
+    // parallel pass draws nothing itself
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (!enemies.isAlive(i) || enemies.type[i] != EnemyType::BASIC) {
+            continue;
+        }
+
+        // Same test as updateEnemyBehavior makes before steering
+        float dx = player.x - enemies.x[i];
+        float dy = player.y - enemies.y[i];
+        if (sqrt(dx * dx + dy * dy) > 0) {
+            // Reduce randomness to avoid jitter: one change per 30 steps of
+            // 1/60 s, whatever the tick rate
+            basicSteerTime += deltaTime * 60.0f;
+
+            if (basicSteerTime >= 30.0f) {
+                basicSteerTime -= 30.0f;
+                // Only change direction occasionally
+                Rng& rng = random.stream(RngStream::AI);
+                steerJitter[i].active = true;
+                steerJitter[i].dx = rng.uniform(-0.1f, 0.1f);
+                steerJitter[i].dy = rng.uniform(-0.1f, 0.1f);
+            }
+        }
+    }
 }
 
-void Game::updateEnemyBehavior(Tank& enemy, float deltaTime) {
-    if (!enemy.alive || !player.alive) {
+void Game::updateEnemyBehavior(int enemy, float deltaTime) {
+    if (!enemies.isAlive(enemy) || !player.alive) {
         return;
     }
 
     // Add smooth movement
-    float smoothingFactor = 0.05f; // Lower value = smoother movement
+    // Lower value = smoother movement; tuned per 1/60 s step
+    const float step = deltaTime * 60.0f;
+    float smoothingFactor = 0.05f * step;
 
-    if (enemy.type == EnemyType::FAST) {
-        float dx = player.x - enemy.x;
-        float dy = player.y - enemy.y;
+    if (enemies.type[enemy] == EnemyType::FAST) {
+        float dx = player.x - enemies.x[enemy];
+        float dy = player.y - enemies.y[enemy];
         float distance = sqrt(dx * dx + dy * dy);
 
         if (distance > 300) {
             // Smoother movement when approaching player
-            float targetVx = dx / distance * enemy.speed;
-            float targetVy = dy / distance * enemy.speed;
+            float targetVx = dx / distance * enemies.speed[enemy];
+            float targetVy = dy / distance * enemies.speed[enemy];
 
             // Smooth velocity instead of abrupt changes
-            enemy.vx += (targetVx - enemy.vx) * smoothingFactor;
-            enemy.vy += (targetVy - enemy.vy) * smoothingFactor;
+            enemies.vx[enemy] += (targetVx - enemies.vx[enemy]) * smoothingFactor;
+            enemies.vy[enemy] += (targetVy - enemies.vy[enemy]) * smoothingFactor;
         } else {
             // Smoother circular movement
             float circleAngle = atan2(dy, dx) + M_PI / 2;
-            float targetVx = cos(circleAngle) * enemy.speed;
-            float targetVy = sin(circleAngle) * enemy.speed;
+            float targetVx = cos(circleAngle) * enemies.speed[enemy];
+            float targetVy = sin(circleAngle) * enemies.speed[enemy];
 
-            enemy.vx += (targetVx - enemy.vx) * smoothingFactor;
-            enemy.vy += (targetVy - enemy.vy) * smoothingFactor;
+            enemies.vx[enemy] += (targetVx - enemies.vx[enemy]) * smoothingFactor;
+            enemies.vy[enemy] += (targetVy - enemies.vy[enemy]) * smoothingFactor;
         }
 
         // Smoother rotation
         float targetAngle = atan2(dy, dx);
-        float angleDiff = targetAngle - enemy.angle;
+        float angleDiff = targetAngle - enemies.angle[enemy];
 
         // Normalize angle to [-PI, PI]
         while (angleDiff > M_PI) {
@@ -1093,10 +1676,10 @@ void Game::updateEnemyBehavior(Tank& enemy, float deltaTime) {
             angleDiff += 2 * M_PI;
         }
 
-        enemy.angle += angleDiff * smoothingFactor * 2.0f;
-    } else if (enemy.type == EnemyType::HEAVY) {
-        float dx = player.x - enemy.x;
-        float dy = player.y - enemy.y;
+        enemies.angle[enemy] += angleDiff * smoothingFactor * 2.0f;
+    } else if (enemies.type[enemy] == EnemyType::HEAVY) {
+        float dx = player.x - enemies.x[enemy];
+        float dy = player.y - enemies.y[enemy];
         float distance = sqrt(dx * dx + dy * dy);
 
         if (distance > 0) {
@@ -1104,42 +1687,37 @@ void Game::updateEnemyBehavior(Tank& enemy, float deltaTime) {
             dy /= distance;
 
             // Smooth velocity
-            float targetVx = dx * enemy.speed;
-            float targetVy = dy * enemy.speed;
+            float targetVx = dx * enemies.speed[enemy];
+            float targetVy = dy * enemies.speed[enemy];
 
-            enemy.vx += (targetVx - enemy.vx) * smoothingFactor * 0.5f; // Heavy tank moves slower
-            enemy.vy += (targetVy - enemy.vy) * smoothingFactor * 0.5f;
+            enemies.vx[enemy] += (targetVx - enemies.vx[enemy]) * smoothingFactor * 0.5f; // Heavy tank moves slower
+            enemies.vy[enemy] += (targetVy - enemies.vy[enemy]) * smoothingFactor * 0.5f;
 
             // Smoother rotation
             float targetAngle = atan2(dy, dx);
-            float angleDiff = targetAngle - enemy.angle;
+            float angleDiff = targetAngle - enemies.angle[enemy];
 
             // Normalize angle
             while (angleDiff > M_PI) angleDiff -= 2 * M_PI;
             while (angleDiff < -M_PI) angleDiff += 2 * M_PI;
 
-            enemy.angle += angleDiff * smoothingFactor;
+            enemies.angle[enemy] += angleDiff * smoothingFactor;
         }
     } else {
         // Basic tank
-        float dx = player.x - enemy.x;
-        float dy = player.y - enemy.y;
+        float dx = player.x - enemies.x[enemy];
+        float dy = player.y - enemies.y[enemy];
         float distance = sqrt(dx * dx + dy * dy);
 
         if (distance > 0) {
             dx /= distance;
             dy /= distance;
 
-            // Reduce randomness to avoid jitter
-            static int frameCount = 0;
-            frameCount++;
-
-            if (frameCount % 30 == 0) {
-                // Only change direction occasionally
-                uniform_real_distribution<float> randDist(-0.1f, 0.1f);
-                mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
-                dx += randDist(rng);
-                dy += randDist(rng);
+            // Occasional heading change, drawn by drawSteerJitter()
+            const SteerJitter& jitter = steerJitter[enemy];
+            if (jitter.active) {
+                dx += jitter.dx;
+                dy += jitter.dy;
 
                 // Normalize again
                 float newDist = sqrt(dx * dx + dy * dy);
@@ -1150,43 +1728,43 @@ void Game::updateEnemyBehavior(Tank& enemy, float deltaTime) {
             }
 
             // Smooth velocity
-            float targetVx = dx * enemy.speed;
-            float targetVy = dy * enemy.speed;
+            float targetVx = dx * enemies.speed[enemy];
+            float targetVy = dy * enemies.speed[enemy];
 
-            enemy.vx += (targetVx - enemy.vx) * smoothingFactor;
-            enemy.vy += (targetVy - enemy.vy) * smoothingFactor;
+            enemies.vx[enemy] += (targetVx - enemies.vx[enemy]) * smoothingFactor;
+            enemies.vy[enemy] += (targetVy - enemies.vy[enemy]) * smoothingFactor;
 
             // Smoother rotation
             float targetAngle = atan2(dy, dx);
-            float angleDiff = targetAngle - enemy.angle;
+            float angleDiff = targetAngle - enemies.angle[enemy];
 
             // Normalize angle
             while (angleDiff > M_PI) angleDiff -= 2 * M_PI;
             while (angleDiff < -M_PI) angleDiff += 2 * M_PI;
 
-            enemy.angle += angleDiff * smoothingFactor;
+            enemies.angle[enemy] += angleDiff * smoothingFactor;
         }
     }
 }
 
-void Game::enemyShoot(Tank& enemy) {
-    if (!enemy.alive || !player.alive) {
+void Game::enemyShoot(int enemy, CommandBuffer& commands) {
+    if (!enemies.isAlive(enemy) || !player.alive) {
         return;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
+    Uint32 currentTime = clock->now();
     Uint32 shootDelay = ENEMY_SHOOT_DELAY;
 
     // Adjust shoot delay based on enemy type
-    if (enemy.type == EnemyType::FAST) {
+    if (enemies.type[enemy] == EnemyType::FAST) {
         shootDelay = ENEMY_SHOOT_DELAY - 1000;
-    } else if (enemy.type == EnemyType::HEAVY) {
+    } else if (enemies.type[enemy] == EnemyType::HEAVY) {
         shootDelay = ENEMY_SHOOT_DELAY + 1000;
     }
 
-    if (currentTime - enemy.lastShotTime >= shootDelay) {
-        float dx = player.x - enemy.x;
-        float dy = player.y - enemy.y;
+    if (currentTime - enemies.lastShotTime[enemy] >= shootDelay) {
+        float dx = player.x - enemies.x[enemy];
+        float dy = player.y - enemies.y[enemy];
         float length = sqrt(dx * dx + dy * dy);
 
         if (length != 0) {
@@ -1194,22 +1772,21 @@ void Game::enemyShoot(Tank& enemy) {
             dy /= length;
         }
 
-        Bullet bullet(
-            enemy.x + enemy.collisionRadius * dx,
-            enemy.y + enemy.collisionRadius * dy,
+        commands.spawnBullet(
+            enemies.x[enemy] + enemies.radius[enemy] * dx,
+            enemies.y[enemy] + enemies.radius[enemy] * dy,
             BULLET_SPEED * dx,
             BULLET_SPEED * dy,
             true,
-            enemy.damage
+            enemies.damage[enemy]
         );
-        bullets.push_back(bullet);
-        enemy.lastShotTime = currentTime;
+        enemies.lastShotTime[enemy] = currentTime;
 
         // Add muzzle flash particles
         SDL_Color color = {255, 0, 0, 255};
-        particles.emit(
-            enemy.x + enemy.collisionRadius * dx,
-            enemy.y + enemy.collisionRadius * dy,
+        commands.emitParticles(
+            enemies.x[enemy] + enemies.radius[enemy] * dx,
+            enemies.y[enemy] + enemies.radius[enemy] * dy,
             atan2(dy, dx),
             10,
             color
@@ -1217,67 +1794,83 @@ void Game::enemyShoot(Tank& enemy) {
     }
 }
 
+void Game::rebuildEnemyGrid() {
+    enemyGrid.clear();
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (enemies.isAlive(i)) {
+            enemyGrid.insert(i, enemies.x[i], enemies.y[i], enemies.radius[i]);
+        }
+    }
+    enemyGrid.build();
+}
+
 void Game::handleCollisions() {
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
+    rebuildEnemyGrid();
 
     // Bullet collisions
-    for (auto& bullet : bullets) {
-        if (!bullet.active) {
+    for (int b = 0; b < bullets.size(); ++b) {
+        if (!bullets.isActive(b)) {
             continue;
         }
 
-        if (!bullet.fromEnemy) {
-            // Player bullets hitting enemies
-            for (auto& enemy : enemies) {
-                if (!enemy.alive) {
+        float bulletX = bullets.x[b];
+        float bulletY = bullets.y[b];
+        bool special = bullets.isSpecial(b);
+
+        if (!bullets.isFromEnemy(b)) {
+            // Player bullets hitting enemies: only enemies binned near the bullet
+            enemyGrid.query(bulletX, bulletY, 0.0f, nearbyItems);
+            for (int enemy : nearbyItems) {
+                if (!enemies.isAlive(enemy)) {
                     continue;
                 }
 
-                if (sqrt(pow(bullet.x - enemy.x, 2) + pow(bullet.y - enemy.y, 2)) < enemy.collisionRadius) {
-                    bullet.active = false;
-                    enemy.hp -= bullet.damage;
+                float dx = bulletX - enemies.x[enemy];
+                float dy = bulletY - enemies.y[enemy];
+                if (dx * dx + dy * dy < enemies.radius[enemy] * enemies.radius[enemy]) {
+                    bullets.kill(b);
+                    enemies.hp[enemy] -= bullets.damage[b];
 
                     // Hit particles
                     SDL_Color hitColor = {255, 200, 0, 255};
-                    particles.emit(bullet.x, bullet.y, atan2(bullet.vy, bullet.vx) + M_PI, 15, hitColor);
+                    particles.emit(bulletX, bulletY, atan2(bullets.vy[b], bullets.vx[b]) + M_PI, 15, hitColor);
 
-                    if (enemy.hp <= 0) {
-                        enemy.alive = false;
-                        Explosion explosion(enemy.x, enemy.y, bullet.isSpecial);
+                    if (enemies.hp[enemy] <= 0) {
+                        enemies.kill(enemy);
+                        Explosion explosion(enemies.x[enemy], enemies.y[enemy], clock->now(), special);
                         explosions.push_back(explosion);
 
                         if (explosionSound) {
-                            Mix_PlayChannel(-1, explosionSound, 0);
+                            VoiceManager::play(SoundId::EXPLOSION, explosionSound);
                         }
 
                         // Screen shake on enemy destruction
-                        activateScreenShake(bullet.isSpecial ? 6.0f : 4.0f, bullet.isSpecial ? 300 : 200);
+                        activateScreenShake(special ? 6.0f : 4.0f, special ? 300 : 200);
 
                         stats.tanksDestroyed++;
-                        stats.score += enemy.type == EnemyType::BASIC ? 100 : (enemy.type == EnemyType::FAST ? 150 : 200);
+                        stats.score += enemies.type[enemy] == EnemyType::BASIC ? 100 : (enemies.type[enemy] == EnemyType::FAST ? 150 : 200);
 
                         // Add kill notification
-                        killNotifications.push_back(KillNotification("KILL"));
+                        killNotifications.push_back(KillNotification("KILL", clock->now()));
 
                         // Increase max health for every 5 enemies killed
                         if (stats.tanksDestroyed % 5 == 0) {
                             player.maxHp += 50;
 
                             // Add notification for max health increase
-                            killNotifications.push_back(KillNotification("MAX HP +50"));
+                            killNotifications.push_back(KillNotification("MAX HP +50", clock->now()));
 
                             // Visual effect for max HP increase
                             SDL_Color hpColor = {0, 255, 0, 255};
-                            particles.emitCircle(player.x, player.y, 60, 40, hpColor, 80);
+                            particles.emitCircle(player.x, player.y, 60, 40, hpColor, 1.33f);
                         }
 
                         // Chance to drop power-up
-                        uniform_int_distribution<int> dropDist(0, 100);
-                        if (dropDist(rng) < 30) {
+                        Rng& rng = random.stream(RngStream::SPAWN);
+                        if (rng.uniformInt(0, 100) < 30) {
                             // 30% chance
-                            uniform_int_distribution<int> typeDist(0, 4);
-                            PowerUpType type = static_cast<PowerUpType>(typeDist(rng));
-                            PowerUp powerup(enemy.x, enemy.y, type);
+                            PowerUpType type = static_cast<PowerUpType>(rng.uniformInt(0, 4));
+                            PowerUp powerup(enemies.x[enemy], enemies.y[enemy], type, clock->now());
                             powerups.push_back(powerup);
                         }
                     }
@@ -1286,33 +1879,35 @@ void Game::handleCollisions() {
             }
         } else if (player.alive) {
             // Enemy bullets hitting player
-            if (sqrt(pow(bullet.x - player.x, 2) + pow(bullet.y - player.y, 2)) < player.collisionRadius) {
+            float dx = bulletX - player.x;
+            float dy = bulletY - player.y;
+            if (dx * dx + dy * dy < player.collisionRadius * player.collisionRadius) {
                 if (player.isShielding) {
                     // Shield deflects bullet
-                    bullet.active = false;
+                    bullets.kill(b);
 
                     // Shield particles
                     SDL_Color shieldColor = {0, 255, 255, 255};
-                    particles.emit(bullet.x, bullet.y, atan2(bullet.vy, bullet.vx) + M_PI, 20, shieldColor);
+                    particles.emit(bulletX, bulletY, atan2(bullets.vy[b], bullets.vx[b]) + M_PI, 20, shieldColor);
                 } else {
                     // Player is not shielded
-                    bullet.active = false;
-                    player.hp -= bullet.damage;
+                    bullets.kill(b);
+                    player.hp -= bullets.damage[b];
 
                     // Hit particles
                     SDL_Color hitColor = {255, 0, 0, 255};
-                    particles.emit(bullet.x, bullet.y, atan2(bullet.vy, bullet.vx) + M_PI, 15, hitColor);
+                    particles.emit(bulletX, bulletY, atan2(bullets.vy[b], bullets.vx[b]) + M_PI, 15, hitColor);
 
                     // Screen shake when player is hit
                     activateScreenShake(3.0f, 150);
 
                     if (player.hp <= 0) {
                         player.alive = false;
-                        Explosion explosion(player.x, player.y);
+                        Explosion explosion(player.x, player.y, clock->now());
                         explosions.push_back(explosion);
 
                         if (explosionSound) {
-                            Mix_PlayChannel(-1, explosionSound, 0);
+                            VoiceManager::play(SoundId::EXPLOSION, explosionSound);
                         }
 
                         // Major screen shake on player death
@@ -1324,15 +1919,24 @@ void Game::handleCollisions() {
     }
 
     // Tank-tank collisions
+    // Pushes below move tanks by at most a few pixels, so widen queries slightly
+    const float pushSlack = 4.0f;
+
     // Player-enemy collisions
-    for (auto& enemy : enemies) {
-        if (player.alive && enemy.alive) {
-            float dx = enemy.x - player.x;
-            float dy = enemy.y - player.y;
-            float distance = sqrt(dx * dx + dy * dy);
-            float minDistance = player.collisionRadius + enemy.collisionRadius;
-
-            if (distance < minDistance) {
+    if (player.alive) {
+        enemyGrid.query(player.x, player.y, player.collisionRadius + pushSlack, nearbyItems);
+    } else {
+        nearbyItems.clear();
+    }
+    for (int enemy : nearbyItems) {
+        if (player.alive && enemies.isAlive(enemy)) {
+            float dx = enemies.x[enemy] - player.x;
+            float dy = enemies.y[enemy] - player.y;
+            float distanceSq = dx * dx + dy * dy;
+            float minDistance = player.collisionRadius + enemies.radius[enemy];
+
+            if (distanceSq < minDistance * minDistance) {
+                float distance = sqrt(distanceSq);
                 if (distance < 0.1f) {
                     // Avoid division by very small numbers
                     dx = 1.0f;
@@ -1347,8 +1951,8 @@ void Game::handleCollisions() {
                 float pushForce = TANK_COLLISION_FORCE * 0.7f;
                 player.vx -= dx * pushForce;
                 player.vy -= dy * pushForce;
-                enemy.vx += dx * pushForce;
-                enemy.vy += dy * pushForce;
+                enemies.vx[enemy] += dx * pushForce;
+                enemies.vy[enemy] += dy * pushForce;
 
                 float overlap = (minDistance - distance) / 2.0f;
                 if (overlap > 0) {
@@ -1358,8 +1962,8 @@ void Game::handleCollisions() {
 
                     player.x -= dx * overlap;
                     player.y -= dy * overlap;
-                    enemy.x += dx * overlap;
-                    enemy.y += dy * overlap;
+                    enemies.x[enemy] += dx * overlap;
+                    enemies.y[enemy] += dy * overlap;
                 }
 
                 // Collision particles
@@ -1378,16 +1982,21 @@ void Game::handleCollisions() {
         }
     }
 
-    // Enemy-enemy collisions
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        for (size_t j = i + 1; j < enemies.size(); ++j) {
-            if (enemies[i].alive && enemies[j].alive) {
-                float dx = enemies[j].x - enemies[i].x;
-                float dy = enemies[j].y - enemies[i].y;
-                float distance = sqrt(dx * dx + dy * dy);
-                float minDistance = enemies[i].collisionRadius + enemies[j].collisionRadius;
-
-                if (distance < minDistance) {
+    // Enemy-enemy collisions: each pair once, lower index first
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (!enemies.isAlive(i)) {
+            continue;
+        }
+        enemyGrid.query(enemies.x[i], enemies.y[i], enemies.radius[i] + pushSlack, neighbourItems, i);
+        for (int j : neighbourItems) {
+            if (enemies.isAlive(j)) {
+                float dx = enemies.x[j] - enemies.x[i];
+                float dy = enemies.y[j] - enemies.y[i];
+                float distanceSq = dx * dx + dy * dy;
+                float minDistance = enemies.radius[i] + enemies.radius[j];
+
+                if (distanceSq < minDistance * minDistance) {
+                    float distance = sqrt(distanceSq);
                     if (distance < 0.1f) {
                         // Avoid division by very small numbers
                         dx = 1.0f;
@@ -1400,10 +2009,10 @@ void Game::handleCollisions() {
 
                     // Reduce push force to avoid jitter
                     float pushForce = TANK_COLLISION_FORCE * 0.5f;
-                    enemies[i].vx -= dx * pushForce;
-                    enemies[i].vy -= dy * pushForce;
-                    enemies[j].vx += dx * pushForce;
-                    enemies[j].vy += dy * pushForce;
+                    enemies.vx[i] -= dx * pushForce;
+                    enemies.vy[i] -= dy * pushForce;
+                    enemies.vx[j] += dx * pushForce;
+                    enemies.vy[j] += dy * pushForce;
 
                     float overlap = (minDistance - distance) / 2.0f;
                     if (overlap > 0) {
@@ -1411,10 +2020,10 @@ void Game::handleCollisions() {
                         float maxPush = 2.0f;
                         overlap = min(overlap, maxPush);
 
-                        enemies[i].x -= dx * overlap;
-                        enemies[i].y -= dy * overlap;
-                        enemies[j].x += dx * overlap;
-                        enemies[j].y += dy * overlap;
+                        enemies.x[i] -= dx * overlap;
+                        enemies.y[i] -= dy * overlap;
+                        enemies.x[j] += dx * overlap;
+                        enemies.y[j] += dy * overlap;
                     }
                 }
             }
@@ -1422,35 +2031,52 @@ void Game::handleCollisions() {
     }
 
     // Power-up collisions
-    for (auto& powerup : powerups) {
+    powerUpGrid.clear();
+    for (size_t i = 0; i < powerups.size(); ++i) {
+        if (powerups[i].active) {
+            powerUpGrid.insert(static_cast<int>(i), powerups[i].x, powerups[i].y, 0.0f);
+        }
+    }
+    powerUpGrid.build();
+
+    const float pickupRadius = player.collisionRadius + 15;
+    if (player.alive) {
+        powerUpGrid.query(player.x, player.y, pickupRadius, nearbyItems);
+    } else {
+        nearbyItems.clear();
+    }
+    for (int index : nearbyItems) {
+        PowerUp& powerup = powerups[index];
         if (powerup.active && player.alive) {
-            if (sqrt(pow(powerup.x - player.x, 2) + pow(powerup.y - player.y, 2)) < player.collisionRadius + 15) {
+            float dx = powerup.x - player.x;
+            float dy = powerup.y - player.y;
+            if (dx * dx + dy * dy < pickupRadius * pickupRadius) {
                 if (powerup.type == PowerUpType::HEALTH_PICKUP) {
                     player.healthPickups++;
                     powerup.active = false;
 
                     // Play pickup sound
                     if (powerupSound) {
-                        Mix_PlayChannel(-1, powerupSound, 0);
+                        VoiceManager::play(SoundId::POWERUP, powerupSound);
                     }
 
                     // Health pickup particles
                     SDL_Color healthColor = {255, 0, 0, 255};
-                    particles.emit(powerup.x, powerup.y, 0, 20, healthColor, 40);
+                    particles.emit(powerup.x, powerup.y, 0, 20, healthColor, 0.67f);
 
                     // Add notification
-                    killNotifications.push_back(KillNotification("HEALTH PACK +1"));
+                    killNotifications.push_back(KillNotification("HEALTH PACK +1", clock->now()));
                 } else {
                     applyPowerUp(powerup);
                     powerup.active = false;
 
                     if (powerupSound) {
-                        Mix_PlayChannel(-1, powerupSound, 0);
+                        VoiceManager::play(SoundId::POWERUP, powerupSound);
                     }
 
                     // Power-up particles
                     SDL_Color powerupColor = {0, 255, 0, 255};
-                    particles.emit(powerup.x, powerup.y, 0, 30, powerupColor, 60);
+                    particles.emit(powerup.x, powerup.y, 0, 30, powerupColor, 1.0f);
                 }
             }
         }
@@ -1477,7 +2103,7 @@ void Game::applyPowerUp(const PowerUp& powerup) {
 
         case PowerUpType::RAPID_FIRE:
             rapidFire.active = true;
-            rapidFire.startTime = SDL_GetTicks();
+            rapidFire.startTime = clock->now();
             rapidFire.lastShotTime = 0;
             rapidFire.lastActivationTime = rapidFire.startTime;
             rapidFire.cooldownRemaining = 0; // Reset cooldown
@@ -1490,12 +2116,10 @@ void Game::applyPowerUp(const PowerUp& powerup) {
 
 void Game::cleanup() {
     // Remove inactive bullets
-    bullets.erase(remove_if(bullets.begin(), bullets.end(),
-                            [](const Bullet& b) { return !b.active; }), bullets.end());
+    bullets.compact();
 
     // Remove dead enemies
-    enemies.erase(remove_if(enemies.begin(), enemies.end(),
-                            [](const Tank& e) { return !e.alive; }), enemies.end());
+    enemies.compact();
 
     // Remove finished explosions
     explosions.erase(remove_if(explosions.begin(), explosions.end(),
@@ -1507,9 +2131,17 @@ void Game::cleanup() {
 }
 
 void Game::reset() {
+    finishRun();
+
+    // Every run starts from the same clock and its own random streams, so
+    // its input alone is enough to replay it
+    random.beginRun(nextRunIndex);
+    if (clock == &simulationClock) {
+        simulationClock = ManualClock();
+    }
+
     player = Tank(MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f, playerTexture);
     player.shieldTexture = playerShieldTexture;
-    player.isPlayer = true; // Set player flag
     player.specialBullets = 0;
     player.healthPickups = 0;
     enemies.clear();
@@ -1517,75 +2149,125 @@ void Game::reset() {
     explosions.clear();
     powerups.clear();
     killNotifications.clear();
+    particles.clear();
     stats = {0, 0, 0, 1};
     rapidFire = {false, 0, 0, 0, 0};
     screenShake = {false, 0.0f, 0, 0};
-    lastSpawnTime = SDL_GetTicks();
-    lastPowerUpTime = SDL_GetTicks();
-    lastHealthPickupTime = SDL_GetTicks();
+    healthRegenInfo = {false, 0, 0};
+    lastSpawnTime = clock->now();
+    lastPowerUpTime = clock->now();
+    lastHealthPickupTime = clock->now();
     shieldStartTime = 0;
+    lastShieldTime = 0;
     shieldCooldownRemaining = 0;
+    lastSpawnEdge = -1;
+    basicSteerTime = 0.0f;
     difficulty = 1;
     gameTime = 0.0f;
     normalCameraZoom = 1.0f;
     currentCameraZoom = 1.0f;
+    paused = false;
+    mouseHeld = false;
+    rightMouseHeld = false;
+    keyAHeld = false;
+    lastHeadlessShotTime = 0;
+    pendingInput.clear();
+    runTick = 0;
+    updateCamera();
+    prevCameraX = cameraX;
+    prevCameraY = cameraY;
+
+    if (!recordPath.empty()) {
+        recording.tickRate = tickRate;
+        recording.masterSeed = random.getSeed();
+        recording.runs.push_back({nextRunIndex, 0, 0, {}});
+        recordingRun = true;
+    }
+    nextRunIndex++;
+
+    // Otherwise the first frame of a new run would still show the last one
+    if (!headless) {
+        publishSnapshot(0.0f);
+    }
 
     // Xoá cập nhật stats ở đây vì đã chuyển sang updateStatsAfterGameOver
 }
 
-void Game::renderGame() {
+void Game::renderWorld(WorldSnapshot& world) {
+    ProfileScope scope(ProfileZone::WORLD);
+
+    // Camera blended between the last two ticks, matching the entities
+    float viewX = world.prevCameraX + (world.cameraX - world.prevCameraX) * renderAlpha;
+    float viewY = world.prevCameraY + (world.cameraY - world.prevCameraY) * renderAlpha;
+
     // Render game border
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
     SDL_Rect borderRect = {
-        BORDER_OFFSET - static_cast<int>(cameraX),
-        BORDER_OFFSET - static_cast<int>(cameraY),
+        BORDER_OFFSET - static_cast<int>(viewX),
+        BORDER_OFFSET - static_cast<int>(viewY),
         MAP_WIDTH - 2 * BORDER_OFFSET,
         MAP_HEIGHT - 2 * BORDER_OFFSET
     };
     SDL_RenderDrawRect(renderer, &borderRect);
 
-    // Render bullets
-    for (auto& bullet : bullets) {
-        bullet.render(renderer, cameraX, cameraY);
+    // Render special targeting line if active
+    if (world.player.isSpecialActive) {
+        renderSpecialTargetingLine(world.player, viewX, viewY);
     }
 
-    // Render power-ups
-    for (auto& powerup : powerups) {
-        powerup.render(renderer, cameraX, cameraY);
+    // Only what overlaps the screen is drawn; drawing is 1:1, so the view is
+    // the window at the interpolated camera
+    SDL_FRect view = {viewX, viewY, static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT)};
+    world.cull(view, renderAlpha, visible);
+
+    // Power-ups, tanks and explosions all come from the game atlas page, so
+    // however many there are they go out in one call
+    for (int i : visible.powerups) {
+        world.powerups[i].render(sprites, viewX, viewY, world.time);
     }
 
-    // Render particles
-    particles.render(renderer, cameraX, cameraY);
+    // The camera follows the player, so it is always on screen
+    world.player.render(sprites, viewX, viewY, renderAlpha);
 
-    // Render special targeting line if active
-    if (player.isSpecialActive) {
-        renderSpecialTargetingLine();
+    world.enemies.render(sprites, enemyTexture, visible.enemies, viewX, viewY, renderAlpha);
+
+    for (int i : visible.explosions) {
+        world.explosions[i].render(sprites, renderer, viewX, viewY);
     }
+    sprites.flush(renderer);
 
-    // Render player
-    player.render(renderer, cameraX, cameraY);
+    // Render bullets and particles in one geometry batch
+    world.bullets.render(geometry, visible.bullets, viewX, viewY, renderAlpha);
+    world.particles.render(geometry, visible.particles, viewX, viewY);
+    geometry.flush(renderer);
 
-    // Render enemies
-    for (auto& enemy : enemies) {
-        enemy.render(renderer, cameraX, cameraY);
-        enemy.renderHealthBar(renderer, cameraX, cameraY);
-    }
+    // Enemy health bars go over everything in the world
+    world.enemies.renderHealthBars(geometry, visible.enemies, viewX, viewY, renderAlpha);
+    geometry.flush(renderer);
 
-    // Render explosions
-    for (auto& explosion : explosions) {
-        explosion.render(renderer, cameraX, cameraY);
+    // Render kill notifications
+    for (auto& notification : world.killNotifications) {
+        notification.render(renderer, textRenderer, world.time);
     }
+}
 
-    // Render kill notifications
-    for (auto& notification : killNotifications) {
-        notification.render(renderer, font);
+void Game::renderGame(WorldSnapshot& world) {
+    renderWorld(world);
+
+    // Render HUD: cached widgets first, then the live minimap markers
+    {
+        ProfileScope scope(ProfileZone::HUD);
+        updateHud(world);
+        hud.render(renderer, textRenderer);
     }
 
-    // Render HUD
-    renderStats();
-    renderMinimap();
+    {
+        ProfileScope scope(ProfileZone::MINIMAP);
+        renderMinimap(world);
+    }
 
     // Render player HP bar at bottom center of screen
+    const Tank& player = world.player;
     if (player.alive) {
         int barWidth = 200;
         int barHeight = 20;
@@ -1606,24 +2288,12 @@ void Game::renderGame() {
         // HP text
         string hpText = to_string(player.hp) + "/" + to_string(player.maxHp) + " HP";
         SDL_Color textColor = {255, 255, 255, 255};
-        SDL_Surface* hpSurface = TTF_RenderText_Solid(font, hpText.c_str(), textColor);
-        if (hpSurface) {
-            SDL_Texture* hpTexture = SDL_CreateTextureFromSurface(renderer, hpSurface);
-            SDL_Rect textRect = {
-                barX + barWidth + 10, barY + (barHeight - hpSurface->h) / 2,
-                hpSurface->w, hpSurface->h
-            };
-            SDL_RenderCopy(renderer, hpTexture, nullptr, &textRect);
-            SDL_FreeSurface(hpSurface);
-            SDL_DestroyTexture(hpTexture);
-        }
+        textRenderer.draw(renderer, hpText, barX + barWidth + 10, barY + (barHeight - textRenderer.textHeight()) / 2, textColor);
     }
 
-    renderCooldowns();
-
     // Render health regeneration info if active
-    if (healthRegenInfo.active) {
-        renderHealthRegenInfo();
+    if (world.healthRegenInfo.active) {
+        renderHealthRegenInfo(world.healthRegenInfo);
     }
 }
 
@@ -1637,14 +2307,14 @@ void Game::updateHealthRegenInfo(float deltaTime) {
     }
 }
 
-void Game::renderHealthRegenInfo() {
-    if (!healthRegenInfo.active) return;
+void Game::renderHealthRegenInfo(const HealthRegenInfo& regen) {
+    if (!regen.active) return;
 
     // Hiển thị thông báo hồi máu ở giữa màn hình
-    string regenText = "HEALING: +" + to_string(healthRegenInfo.amountHealed) + " HP";
+    string regenText = "HEALING: +" + to_string(regen.amountHealed) + " HP";
 
     // Hiển thị thời gian còn lại
-    string timeText = "Time: " + to_string(static_cast<int>(healthRegenInfo.timeLeft * 10) / 10.0f) + "s";
+    string timeText = "Time: " + to_string(static_cast<int>(regen.timeLeft * 10) / 10.0f) + "s";
 
     // Vẽ nền cho thông báo
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
@@ -1659,36 +2329,11 @@ void Game::renderHealthRegenInfo() {
 
     // Hiển thị text
     SDL_Color textColor = {0, 255, 0, 255};
-    SDL_Surface* regenSurface = TTF_RenderText_Solid(font, regenText.c_str(), textColor);
-    if (regenSurface) {
-        SDL_Texture* regenTexture = SDL_CreateTextureFromSurface(renderer, regenSurface);
-        SDL_Rect regenRect = {
-            WINDOW_WIDTH / 2 - regenSurface->w / 2,
-            WINDOW_HEIGHT / 2 - 30,
-            regenSurface->w,
-            regenSurface->h
-        };
-        SDL_RenderCopy(renderer, regenTexture, nullptr, &regenRect);
-        SDL_FreeSurface(regenSurface);
-        SDL_DestroyTexture(regenTexture);
-    }
-
-    SDL_Surface* timeSurface = TTF_RenderText_Solid(font, timeText.c_str(), textColor);
-    if (timeSurface) {
-        SDL_Texture* timeTexture = SDL_CreateTextureFromSurface(renderer, timeSurface);
-        SDL_Rect timeRect = {
-            WINDOW_WIDTH / 2 - timeSurface->w / 2,
-            WINDOW_HEIGHT / 2 + 10,
-            timeSurface->w,
-            timeSurface->h
-        };
-        SDL_RenderCopy(renderer, timeTexture, nullptr, &timeRect);
-        SDL_FreeSurface(timeSurface);
-        SDL_DestroyTexture(timeTexture);
-    }
+    textRenderer.draw(renderer, regenText, WINDOW_WIDTH / 2 - textRenderer.textWidth(regenText) / 2, WINDOW_HEIGHT / 2 - 30, textColor);
+    textRenderer.draw(renderer, timeText, WINDOW_WIDTH / 2 - textRenderer.textWidth(timeText) / 2, WINDOW_HEIGHT / 2 + 10, textColor);
 
     // Hiển thị thanh tiến trình
-    float progress = healthRegenInfo.timeLeft / HEALTH_REGEN_TIME;
+    float progress = regen.timeLeft / HEALTH_REGEN_TIME;
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
     SDL_Rect progressRect = {
         WINDOW_WIDTH / 2 - 100,
@@ -1710,83 +2355,52 @@ void Game::renderHealthRegenInfo() {
 }
 
 
-void Game::renderCooldowns() {
-    // Shield cooldown bar
-    if (shieldCooldownRemaining > 0) {
-        float percentage = 1.0f - (shieldCooldownRemaining / static_cast<float>(SHIELD_COOLDOWN));
-        renderCooldownBar(10, 190, 200, 10, percentage, {0, 255, 255, 255});
+void Game::updateHudCooldowns(const WorldSnapshot& world) {
+    Uint32 currentTime = world.time;
 
-        string cooldownText = "Shield: " + to_string(shieldCooldownRemaining / 1000) + "s";
-        renderText(cooldownText, 10, 205, {255, 255, 255, 255});
-    } else if (!player.isShielding) {
-        renderText("Shield ready (Press E)", 10, 190, {0, 255, 255, 255});
-    } else {
+    // Shield cooldown bar
+    bool shieldCooling = world.shieldCooldownRemaining > 0;
+    bool shieldReady = !shieldCooling && !world.player.isShielding;
+    hud.setVisible(hudWidgets.shieldBar, !shieldReady);
+    hud.setVisible(hudWidgets.shieldTimer, !shieldReady);
+    hud.setVisible(hudWidgets.shieldReady, shieldReady);
+    if (shieldCooling) {
+        hud.setBarFill(hudWidgets.shieldBar, 1.0f - (world.shieldCooldownRemaining / static_cast<float>(SHIELD_COOLDOWN)));
+        hud.setValue(hudWidgets.shieldTimer, world.shieldCooldownRemaining / 1000);
+    } else if (!shieldReady) {
         // Shield active - show duration
-        Uint32 currentTime = SDL_GetTicks();
-        float percentage = 1.0f - ((currentTime - shieldStartTime) / static_cast<float>(SHIELD_DURATION));
-        renderCooldownBar(10, 190, 200, 10, percentage, {0, 255, 255, 255});
-
-        string durationText = "Shield: " + to_string((SHIELD_DURATION - (currentTime - shieldStartTime)) / 1000) + "s";
-        renderText(durationText, 10, 205, {255, 255, 255, 255});
+        hud.setBarFill(hudWidgets.shieldBar, 1.0f - ((currentTime - world.shieldStartTime) / static_cast<float>(SHIELD_DURATION)));
+        hud.setValue(hudWidgets.shieldTimer, (SHIELD_DURATION - (currentTime - world.shieldStartTime)) / 1000);
     }
 
     // Rapid fire cooldown bar
-    if (rapidFire.cooldownRemaining > 0) {
-        float percentage = 1.0f - (rapidFire.cooldownRemaining / static_cast<float>(RAPID_FIRE_COOLDOWN));
-        renderCooldownBar(10, 230, 200, 10, percentage, {255, 100, 0, 255});
-
-        string cooldownText = "Rapid Fire: " + to_string(rapidFire.cooldownRemaining / 1000) + "s";
-        renderText(cooldownText, 10, 245, {255, 255, 255, 255});
-    } else if (!rapidFire.active) {
-        renderText("Rapid Fire ready (Press Q)", 10, 230, {255, 100, 0, 255});
-    } else {
+    bool rapidCooling = world.rapidFire.cooldownRemaining > 0;
+    bool rapidReady = !rapidCooling && !world.rapidFire.active;
+    hud.setVisible(hudWidgets.rapidFireBar, !rapidReady);
+    hud.setVisible(hudWidgets.rapidFireTimer, !rapidReady);
+    hud.setVisible(hudWidgets.rapidFireReady, rapidReady);
+    if (rapidCooling) {
+        hud.setBarFill(hudWidgets.rapidFireBar, 1.0f - (world.rapidFire.cooldownRemaining / static_cast<float>(RAPID_FIRE_COOLDOWN)));
+        hud.setValue(hudWidgets.rapidFireTimer, world.rapidFire.cooldownRemaining / 1000);
+    } else if (!rapidReady) {
         // Rapid fire active - show duration
-        Uint32 currentTime = SDL_GetTicks();
-        float percentage = 1.0f - ((currentTime - rapidFire.startTime) / static_cast<float>(RAPID_FIRE_DURATION));
-        renderCooldownBar(10, 230, 200, 10, percentage, {255, 100, 0, 255});
-
-        string durationText = "Rapid Fire: " + to_string(
-                                  (RAPID_FIRE_DURATION - (currentTime - rapidFire.startTime)) / 1000) + "s";
-        renderText(durationText, 10, 245, {255, 255, 255, 255});
+        hud.setBarFill(hudWidgets.rapidFireBar, 1.0f - ((currentTime - world.rapidFire.startTime) / static_cast<float>(RAPID_FIRE_DURATION)));
+        hud.setValue(hudWidgets.rapidFireTimer, (RAPID_FIRE_DURATION - (currentTime - world.rapidFire.startTime)) / 1000);
     }
 
     // Health pickups
-    if (player.healthPickups > 0) {
-        string healthText = "Health Packs: " + to_string(player.healthPickups) + " (Press S to use)";
-        renderText(healthText, 10, 270, {255, 0, 0, 255});
-    }
-}
-
-void Game::renderCooldownBar(int x, int y, int width, int height, float percentage, SDL_Color color) {
-    // Background
-    SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
-    SDL_Rect bgRect = {x, y, width, height};
-    SDL_RenderFillRect(renderer, &bgRect);
-
-    // Fill
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_Rect fillRect = {x, y, static_cast<int>(width * percentage), height};
-    SDL_RenderFillRect(renderer, &fillRect);
+    hud.setVisible(hudWidgets.healthPacks, world.player.healthPickups > 0);
+    hud.setValue(hudWidgets.healthPacks, world.player.healthPickups);
 }
 
 void Game::renderText(const string& text, int x, int y, SDL_Color color) {
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    if (!textSurface) {
-        return;
-    }
-
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_Rect textRect = {x, y, textSurface->w, textSurface->h};
-    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    textRenderer.draw(renderer, text, x, y, color);
 }
 
 void Game::renderMenu() {
     // Render background
-    if (menuBackgroundTexture) {
-        SDL_RenderCopy(renderer, menuBackgroundTexture, nullptr, nullptr);
+    if (menuBackgroundTexture.ready()) {
+        SDL_RenderCopy(renderer, menuBackgroundTexture.texture(), menuBackgroundTexture.rect(), nullptr);
     } else {
         SDL_SetRenderDrawColor(renderer, 20, 20, 50, 255);
         SDL_RenderClear(renderer);
@@ -1794,27 +2408,16 @@ void Game::renderMenu() {
 
     // Render game title
     SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* titleSurface = TTF_RenderText_Solid(font, "   ", textColor); //Thêm tên ở giữa màn hình
-    if (titleSurface) {
-        SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-        SDL_Rect titleRect = {
-            WINDOW_WIDTH / 2 - titleSurface->w / 2,
-            50,
-            titleSurface->w,
-            titleSurface->h
-        };
-        SDL_RenderCopy(renderer, titleTexture, nullptr, &titleRect);
-        SDL_FreeSurface(titleSurface);
-        SDL_DestroyTexture(titleTexture);
-    }
+    string titleText = "   "; //Thêm tên ở giữa màn hình
+    textRenderer.draw(renderer, titleText, WINDOW_WIDTH / 2 - textRenderer.textWidth(titleText) / 2, 50, textColor);
 
     // Update button animations
     updateButtonAnimations();
 
     // Render buttons with scale animation
     for (const auto& button : menuButtons) {
-        SDL_Texture* currentTexture = button.isHovered ? button.hoverTexture : button.texture;
-        if (currentTexture) {
+        TextureHandle currentTexture = button.isHovered ? button.hoverTexture : button.texture;
+        if (currentTexture.ready()) {
             float scale = buttonAnimations[button.type].scale;
 
             // Calculate scaled dimensions
@@ -1832,7 +2435,7 @@ void Game::renderMenu() {
                 scaledHeight
             };
 
-            SDL_RenderCopy(renderer, currentTexture, nullptr, &scaledRect);
+            SDL_RenderCopy(renderer, currentTexture.texture(), currentTexture.rect(), &scaledRect);
         } else {
             // Fallback button rendering if texture not loaded
             SDL_SetRenderDrawColor(renderer, button.isHovered ? 100 : 70, 100, 200, 255);
@@ -1860,19 +2463,10 @@ void Game::renderMenu() {
                     break;
             }
 
-            SDL_Surface* textSurface = TTF_RenderText_Solid(font, buttonText, textColor);
-            if (textSurface) {
-                SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-                SDL_Rect textRect = {
-                    button.rect.x + (button.rect.w - textSurface->w) / 2,
-                    button.rect.y + (button.rect.h - textSurface->h) / 2,
-                    textSurface->w,
-                    textSurface->h
-                };
-                SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-                SDL_FreeSurface(textSurface);
-                SDL_DestroyTexture(textTexture);
-            }
+            textRenderer.draw(renderer, buttonText,
+                      button.rect.x + (button.rect.w - textRenderer.textWidth(buttonText)) / 2,
+                      button.rect.y + (button.rect.h - textRenderer.textHeight()) / 2,
+                      textColor);
         }
     }
 }
@@ -1886,16 +2480,7 @@ void Game::renderPauseMenu() {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     SDL_Color textColor = {255, 255, 255, 255};
-    SDL_Surface* pauseSurface = TTF_RenderText_Solid(font, "Game Paused", textColor);
-    if (!pauseSurface) {
-        return;
-    }
-
-    SDL_Texture* pauseTexture = SDL_CreateTextureFromSurface(renderer, pauseSurface);
-    SDL_Rect pauseRect = {WINDOW_WIDTH / 2 - pauseSurface->w / 2, WINDOW_HEIGHT / 4, pauseSurface->w, pauseSurface->h};
-    SDL_RenderCopy(renderer, pauseTexture, nullptr, &pauseRect);
-    SDL_FreeSurface(pauseSurface);
-    SDL_DestroyTexture(pauseTexture);
+    textRenderer.draw(renderer, "Game Paused", WINDOW_WIDTH / 2 - textRenderer.textWidth("Game Paused") / 2, WINDOW_HEIGHT / 4, textColor);
 
     SDL_Color resumeColor = hoverPauseResume ? SDL_Color{180, 180, 60, 255} : SDL_Color{0, 128, 255, 255};
     SDL_Color menuColor = hoverPauseMenu ? SDL_Color{180, 180, 60, 255} : SDL_Color{0, 128, 255, 255};
@@ -1910,29 +2495,17 @@ void Game::renderPauseMenu() {
     SDL_SetRenderDrawColor(renderer, menuColor.r, menuColor.g, menuColor.b, menuColor.a);
     SDL_RenderFillRect(renderer, &menuButton);
 
-    SDL_Surface* resumeSurface = TTF_RenderText_Solid(font, "Resume", textColor);
-    SDL_Surface* menuSurface = TTF_RenderText_Solid(font, "Main Menu", textColor);
-    if (!resumeSurface || !menuSurface) return;
-
-    SDL_Texture* resumeTexture = SDL_CreateTextureFromSurface(renderer, resumeSurface);
-    SDL_Texture* menuTexture = SDL_CreateTextureFromSurface(renderer, menuSurface);
-    SDL_Rect resumeTextRect = {
-        WINDOW_WIDTH / 2 - resumeSurface->w / 2, WINDOW_HEIGHT / 2 - BUTTON_HEIGHT / 2 - resumeSurface->h / 2,
-        resumeSurface->w, resumeSurface->h
-    };
-    SDL_Rect menuTextRect = {
-        WINDOW_WIDTH / 2 - menuSurface->w / 2,
-        WINDOW_HEIGHT / 2 + BUTTON_SPACING + BUTTON_HEIGHT / 2 - menuSurface->h / 2, menuSurface->w, menuSurface->h
-    };
-    SDL_RenderCopy(renderer, resumeTexture, nullptr, &resumeTextRect);
-    SDL_RenderCopy(renderer, menuTexture, nullptr, &menuTextRect);
-    SDL_FreeSurface(resumeSurface);
-    SDL_FreeSurface(menuSurface);
-    SDL_DestroyTexture(resumeTexture);
-    SDL_DestroyTexture(menuTexture);
+    textRenderer.draw(renderer, "Resume",
+              WINDOW_WIDTH / 2 - textRenderer.textWidth("Resume") / 2,
+              WINDOW_HEIGHT / 2 - BUTTON_HEIGHT / 2 - textRenderer.textHeight() / 2,
+              textColor);
+    textRenderer.draw(renderer, "Main Menu",
+              WINDOW_WIDTH / 2 - textRenderer.textWidth("Main Menu") / 2,
+              WINDOW_HEIGHT / 2 + BUTTON_SPACING + BUTTON_HEIGHT / 2 - textRenderer.textHeight() / 2,
+              textColor);
 }
 
-void Game::renderGameOver() {
+void Game::renderGameOver(const WorldSnapshot& world) {
     // Semi-transparent overlay
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 200);
     SDL_Rect overlay = {0, 0, WINDOW_WIDTH, WINDOW_HEIGHT};
@@ -1941,37 +2514,14 @@ void Game::renderGameOver() {
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
 
     SDL_Color textColor = {255, 0, 0, 255};
-    SDL_Surface* gameOverSurface = TTF_RenderText_Solid(font, "Game Over!", textColor);
-    if (!gameOverSurface) {
-        return;
-    }
-
-    SDL_Texture* gameOverTexture = SDL_CreateTextureFromSurface(renderer, gameOverSurface);
-    SDL_Rect gameOverRect = {
-        WINDOW_WIDTH / 2 - gameOverSurface->w / 2,
-        WINDOW_HEIGHT / 2 - gameOverSurface->h - 20,
-        gameOverSurface->w,
-        gameOverSurface->h
-    };
-    SDL_RenderCopy(renderer, gameOverTexture, nullptr, &gameOverRect);
-    SDL_FreeSurface(gameOverSurface);
-    SDL_DestroyTexture(gameOverTexture);
+    textRenderer.draw(renderer, "Game Over!",
+              WINDOW_WIDTH / 2 - textRenderer.textWidth("Game Over!") / 2,
+              WINDOW_HEIGHT / 2 - textRenderer.textHeight() - 20,
+              textColor);
 
     // Display score
-    string scoreText = "Final Score: " + to_string(stats.score);
-    SDL_Surface* scoreSurface = TTF_RenderText_Solid(font, scoreText.c_str(), textColor);
-    if (scoreSurface) {
-        SDL_Texture* scoreTexture = SDL_CreateTextureFromSurface(renderer, scoreSurface);
-        SDL_Rect scoreRect = {
-            WINDOW_WIDTH / 2 - scoreSurface->w / 2,
-            WINDOW_HEIGHT / 2,
-            scoreSurface->w,
-            scoreSurface->h
-        };
-        SDL_RenderCopy(renderer, scoreTexture, nullptr, &scoreRect);
-        SDL_FreeSurface(scoreSurface);
-        SDL_DestroyTexture(scoreTexture);
-    }
+    string scoreText = "Final Score: " + to_string(world.stats.score);
+    textRenderer.draw(renderer, scoreText, WINDOW_WIDTH / 2 - textRenderer.textWidth(scoreText) / 2, WINDOW_HEIGHT / 2, textColor);
 
     // Restart button
     SDL_Color restartButtonColor = hoverGameOverRestart ? SDL_Color{180, 180, 60, 255} : SDL_Color{100, 100, 100, 255};
@@ -2012,10 +2562,10 @@ void Game::handleGameOverEvents(SDL_Event& e) {
 
     // Play hover sound when hover state changes
     if (hoverGameOverRestart != prevHoverGameOverRestart && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     if (hoverGameOverMenu != prevHoverGameOverMenu && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
 
     // Update previous hover states
@@ -2032,96 +2582,63 @@ void Game::handleGameOverEvents(SDL_Event& e) {
     }
 }
 
-void Game::renderStats() {
-    SDL_Color textColor = {255, 255, 255, 255};
+void Game::initializeHud() {
+    hud.destroy();
 
-    // Score
-    string scoreText = "Score: " + to_string(stats.score);
-    SDL_Surface* scoreSurface = TTF_RenderText_Solid(font, scoreText.c_str(), textColor);
-    if (scoreSurface) {
-        SDL_Texture* scoreTexture = SDL_CreateTextureFromSurface(renderer, scoreSurface);
-        SDL_Rect scoreRect = {10, 10, scoreSurface->w, scoreSurface->h};
-        SDL_RenderCopy(renderer, scoreTexture, nullptr, &scoreRect);
-        SDL_FreeSurface(scoreSurface);
-        SDL_DestroyTexture(scoreTexture);
-    }
-
-    // Level
-    string levelText = "Level: " + to_string(stats.level);
-    SDL_Surface* levelSurface = TTF_RenderText_Solid(font, levelText.c_str(), textColor);
-    if (levelSurface) {
-        SDL_Texture* levelTexture = SDL_CreateTextureFromSurface(renderer, levelSurface);
-        SDL_Rect levelRect = {10, 40, levelSurface->w, levelSurface->h};
-        SDL_RenderCopy(renderer, levelTexture, nullptr, &levelRect);
-        SDL_FreeSurface(levelSurface);
-        SDL_DestroyTexture(levelTexture);
-    }
-
-    // Bullets fired
-    string bulletsText = "Bullets fired: " + to_string(stats.bulletsFired);
-    SDL_Surface* bulletsSurface = TTF_RenderText_Solid(font, bulletsText.c_str(), textColor);
-    if (bulletsSurface) {
-        SDL_Texture* bulletsTexture = SDL_CreateTextureFromSurface(renderer, bulletsSurface);
-        SDL_Rect bulletsRect = {10, 70, bulletsSurface->w, bulletsSurface->h};
-        SDL_RenderCopy(renderer, bulletsTexture, nullptr, &bulletsRect);
-        SDL_FreeSurface(bulletsSurface);
-        SDL_DestroyTexture(bulletsTexture);
-    }
-
-    // Tanks destroyed
-    string tanksText = "Tanks destroyed: " + to_string(stats.tanksDestroyed);
-    SDL_Surface* tanksSurface = TTF_RenderText_Solid(font, tanksText.c_str(), textColor);
-    if (tanksSurface) {
-        SDL_Texture* tanksTexture = SDL_CreateTextureFromSurface(renderer, tanksSurface);
-        SDL_Rect tanksRect = {10, 100, tanksSurface->w, tanksSurface->h};
-        SDL_RenderCopy(renderer, tanksTexture, nullptr, &tanksRect);
-        SDL_FreeSurface(tanksSurface);
-        SDL_DestroyTexture(tanksTexture);
-    }
-
-    // Special bullets count
+    SDL_Color white = {255, 255, 255, 255};
     SDL_Color specialColor = {255, 0, 255, 255};
-    string specialText = "Special bullets: " + to_string(player.specialBullets) + "/" + to_string(MAX_SPECIAL_BULLETS);
-    SDL_Surface* specialSurface = TTF_RenderText_Solid(font, specialText.c_str(), specialColor);
-    if (specialSurface) {
-        SDL_Texture* specialTexture = SDL_CreateTextureFromSurface(renderer, specialSurface);
-        SDL_Rect specialRect = {10, 130, specialSurface->w, specialSurface->h};
-        SDL_RenderCopy(renderer, specialTexture, nullptr, &specialRect);
-        SDL_FreeSurface(specialSurface);
-        SDL_DestroyTexture(specialTexture);
-    }
-
-    // Add special ability instructions if player has special bullets
-    if (player.specialBullets > 0) {
-        string instructionText = "Hold right-click to charge special shot (A to cancel)";
-        SDL_Surface* instructionSurface = TTF_RenderText_Solid(font, instructionText.c_str(), specialColor);
-        if (instructionSurface) {
-            SDL_Texture* instructionTexture = SDL_CreateTextureFromSurface(renderer, instructionSurface);
-            SDL_Rect instructionRect = {10, 160, instructionSurface->w, instructionSurface->h};
-            SDL_RenderCopy(renderer, instructionTexture, nullptr, &instructionRect);
-            SDL_FreeSurface(instructionSurface);
-            SDL_DestroyTexture(instructionTexture);
-        }
-    }
+    SDL_Color shieldColor = {0, 255, 255, 255};
+    SDL_Color rapidFireColor = {255, 100, 0, 255};
+
+    hudWidgets.score = hud.addLabel(10, 10, "Score: %d", white);
+    hudWidgets.level = hud.addLabel(10, 40, "Level: %d", white);
+    hudWidgets.bulletsFired = hud.addLabel(10, 70, "Bullets fired: %d", white);
+    hudWidgets.tanksDestroyed = hud.addLabel(10, 100, "Tanks destroyed: %d", white);
+    hudWidgets.specialBullets = hud.addLabel(10, 130, "Special bullets: %d/" + to_string(MAX_SPECIAL_BULLETS), specialColor);
+    hudWidgets.specialHint = hud.addLabel(10, 160, "Hold right-click to charge special shot (A to cancel)", specialColor);
+
+    hudWidgets.shieldBar = hud.addBar(10, 190, 200, 10, shieldColor);
+    hudWidgets.shieldTimer = hud.addLabel(10, 205, "Shield: %ds", white);
+    hudWidgets.shieldReady = hud.addLabel(10, 190, "Shield ready (Press E)", shieldColor);
+    hudWidgets.rapidFireBar = hud.addBar(10, 230, 200, 10, rapidFireColor);
+    hudWidgets.rapidFireTimer = hud.addLabel(10, 245, "Rapid Fire: %ds", white);
+    hudWidgets.rapidFireReady = hud.addLabel(10, 230, "Rapid Fire ready (Press Q)", rapidFireColor);
+    hudWidgets.healthPacks = hud.addLabel(10, 270, "Health Packs: %d (Press S to use)", {255, 0, 0, 255});
+
+    // The minimap background and arena border never change
+    hudWidgets.minimap = hud.addPanel(MINIMAP_X, MINIMAP_Y, MINIMAP_WIDTH, MINIMAP_HEIGHT, [](SDL_Renderer* target, int x, int y) {
+        SDL_SetRenderDrawColor(target, 0, 0, 0, 128);
+        SDL_SetRenderDrawBlendMode(target, SDL_BLENDMODE_BLEND);
+        SDL_Rect minimapRect = {x, y, MINIMAP_WIDTH, MINIMAP_HEIGHT};
+        SDL_RenderFillRect(target, &minimapRect);
+        SDL_SetRenderDrawBlendMode(target, SDL_BLENDMODE_NONE);
+
+        SDL_SetRenderDrawColor(target, 0, 255, 0, 255);
+        SDL_Rect borderRect = {
+            x + static_cast<int>(BORDER_OFFSET * MINIMAP_SCALE),
+            y + static_cast<int>(BORDER_OFFSET * MINIMAP_SCALE),
+            static_cast<int>((MAP_WIDTH - 2 * BORDER_OFFSET) * MINIMAP_SCALE),
+            static_cast<int>((MAP_HEIGHT - 2 * BORDER_OFFSET) * MINIMAP_SCALE)
+        };
+        SDL_RenderDrawRect(target, &borderRect);
+    });
 }
 
-void Game::renderMinimap() {
-    // Minimap background
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 128);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    SDL_Rect minimapRect = {MINIMAP_X, MINIMAP_Y, MINIMAP_WIDTH, MINIMAP_HEIGHT};
-    SDL_RenderFillRect(renderer, &minimapRect);
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+void Game::updateHud(const WorldSnapshot& world) {
+    hud.setValue(hudWidgets.score, world.stats.score);
+    hud.setValue(hudWidgets.level, world.stats.level);
+    hud.setValue(hudWidgets.bulletsFired, world.stats.bulletsFired);
+    hud.setValue(hudWidgets.tanksDestroyed, world.stats.tanksDestroyed);
+    hud.setValue(hudWidgets.specialBullets, world.player.specialBullets);
+    hud.setVisible(hudWidgets.specialHint, world.player.specialBullets > 0);
 
-    // Minimap border
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_Rect borderRect = {
-        MINIMAP_X + static_cast<int>(BORDER_OFFSET * MINIMAP_SCALE),
-        MINIMAP_Y + static_cast<int>(BORDER_OFFSET * MINIMAP_SCALE),
-        static_cast<int>((MAP_WIDTH - 2 * BORDER_OFFSET) * MINIMAP_SCALE),
-        static_cast<int>((MAP_HEIGHT - 2 * BORDER_OFFSET) * MINIMAP_SCALE)
-    };
-    SDL_RenderDrawRect(renderer, &borderRect);
+    updateHudCooldowns(world);
+}
+
+void Game::renderMinimap(const WorldSnapshot& world) {
+    // Background and border come from the cached HUD panel
+    const Tank& player = world.player;
+    const EnemyPool& enemies = world.enemies;
 
     // Player on minimap
     if (player.alive) {
@@ -2139,23 +2656,23 @@ void Game::renderMinimap() {
 
     // Enemies on minimap
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    for (const auto& enemy : enemies) {
-        if (enemy.alive) {
-            int ex = MINIMAP_X + static_cast<int>(enemy.x * MINIMAP_SCALE);
-            int ey = MINIMAP_Y + static_cast<int>(enemy.y * MINIMAP_SCALE);
+    for (int i = 0; i < enemies.size(); ++i) {
+        if (enemies.isAlive(i)) {
+            int ex = MINIMAP_X + static_cast<int>(enemies.x[i] * MINIMAP_SCALE);
+            int ey = MINIMAP_Y + static_cast<int>(enemies.y[i] * MINIMAP_SCALE);
             SDL_Rect enemyDot = {ex - 2, ey - 2, 4, 4};
             SDL_RenderFillRect(renderer, &enemyDot);
 
             // Enemy direction
-            int dx = ex + static_cast<int>(10 * cos(enemy.angle));
-            int dy = ey + static_cast<int>(10 * sin(enemy.angle));
+            int dx = ex + static_cast<int>(10 * cos(enemies.angle[i]));
+            int dy = ey + static_cast<int>(10 * sin(enemies.angle[i]));
             SDL_RenderDrawLine(renderer, ex, ey, dx, dy);
         }
     }
 
     // Power-ups on minimap
     SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    for (const auto& powerup : powerups) {
+    for (const auto& powerup : world.powerups) {
         if (powerup.active) {
             int px = MINIMAP_X + static_cast<int>(powerup.x * MINIMAP_SCALE);
             int py = MINIMAP_Y + static_cast<int>(powerup.y * MINIMAP_SCALE);
@@ -2167,8 +2684,8 @@ void Game::renderMinimap() {
     // Camera view rectangle
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
     SDL_Rect cameraRect = {
-        MINIMAP_X + static_cast<int>(cameraX * MINIMAP_SCALE),
-        MINIMAP_Y + static_cast<int>(cameraY * MINIMAP_SCALE),
+        MINIMAP_X + static_cast<int>(world.cameraX * MINIMAP_SCALE),
+        MINIMAP_Y + static_cast<int>(world.cameraY * MINIMAP_SCALE),
         static_cast<int>(WINDOW_WIDTH * MINIMAP_SCALE),
         static_cast<int>(WINDOW_HEIGHT * MINIMAP_SCALE)
     };
@@ -2177,10 +2694,10 @@ void Game::renderMinimap() {
 
 void Game::initializeMenu() {
     // Load menu background
-    menuBackgroundTexture = ResourceManager::loadTexture("assets/images/ui/menu_background.png", renderer);
+    menuBackgroundTexture = ResourceManager::loadTexture(TextureId::MENU_BACKGROUND, renderer);
 
     // Load hover sound
-    buttonHoverSound = ResourceManager::loadSound("assets/sounds/button_hover.mp3");
+    buttonHoverSound = ResourceManager::soundHandle(SoundId::BUTTON_HOVER);
 
     // Initialize menu buttons
     const int buttonWidth = 330;
@@ -2188,20 +2705,20 @@ void Game::initializeMenu() {
     const int buttonSpacing = 15;
     const int startY = WINDOW_HEIGHT / 2 - (5 * buttonHeight + 4 * buttonSpacing) / 2;
 
-    vector<string> buttonImages = {
-        "assets/images/ui/button_start.png",
-        "assets/images/ui/button_stats.png",
-        "assets/images/ui/button_tutorial.png",
-        "assets/images/ui/button_settings.png",
-        "assets/images/ui/button_exit.png"
+    vector<TextureId> buttonImages = {
+        TextureId::BUTTON_START,
+        TextureId::BUTTON_STATS,
+        TextureId::BUTTON_TUTORIAL,
+        TextureId::BUTTON_SETTINGS,
+        TextureId::BUTTON_EXIT
     };
 
-    vector<string> buttonHoverImages = {
-        "assets/images/ui/button_start_hover.png",
-        "assets/images/ui/button_stats_hover.png",
-        "assets/images/ui/button_tutorial_hover.png",
-        "assets/images/ui/button_settings_hover.png",
-        "assets/images/ui/button_exit_hover.png"
+    vector<TextureId> buttonHoverImages = {
+        TextureId::BUTTON_START_HOVER,
+        TextureId::BUTTON_STATS_HOVER,
+        TextureId::BUTTON_TUTORIAL_HOVER,
+        TextureId::BUTTON_SETTINGS_HOVER,
+        TextureId::BUTTON_EXIT_HOVER
     };
 
     for (int i = 0; i < 5; i++) {
@@ -2221,6 +2738,47 @@ void Game::initializeMenu() {
     }
 }
 
+void Game::updateLoading() {
+    assetsLoaded = ResourceManager::pumpLoading(renderer, LOADING_UPLOAD_BUDGET_MS);
+
+    // The menu only needs its own group; game assets keep streaming behind it
+    if (menuButtons.empty() && ResourceManager::isGroupLoaded(LoadGroup::MENU)) {
+        initializeMenu();
+    }
+
+    if (state != GameState::LOADING) {
+        return;
+    }
+
+    if (startAfterLoading) {
+        if (assetsLoaded) {
+            startAfterLoading = false;
+            state = GameState::PLAYING;
+            reset();
+        }
+    } else if (!menuButtons.empty()) {
+        state = GameState::MENU;
+    }
+}
+
+void Game::renderLoadingScreen() {
+    SDL_Color textColor = {255, 255, 255, 255};
+    string loadingText = "Loading...";
+    renderText(loadingText, WINDOW_WIDTH / 2 - textRenderer.textWidth(loadingText) / 2, WINDOW_HEIGHT / 2 - 50, textColor);
+
+    // Progress bar
+    int barWidth = 400;
+    int barHeight = 20;
+    SDL_Rect bgRect = {WINDOW_WIDTH / 2 - barWidth / 2, WINDOW_HEIGHT / 2, barWidth, barHeight};
+    SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+    SDL_RenderFillRect(renderer, &bgRect);
+
+    SDL_Rect fillRect = bgRect;
+    fillRect.w = static_cast<int>(barWidth * ResourceManager::loadingProgress());
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+    SDL_RenderFillRect(renderer, &fillRect);
+}
+
 void Game::updateButtonAnimations() {
     Uint32 currentTime = SDL_GetTicks();
     float animationSpeed = 0.08f;
@@ -2249,7 +2807,7 @@ void Game::handleTutorialEvents(SDL_Event& e) {
                         mouseY >= WINDOW_HEIGHT - BUTTON_HEIGHT - 20 &&
                         mouseY <= WINDOW_HEIGHT - 20);
     if (hoverBackTutorial != prevHoverBackTutorial && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     prevHoverBackTutorial = hoverBackTutorial;
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
@@ -2320,7 +2878,7 @@ void Game::handleSettingsEvents(SDL_Event& e) {
                         mouseY >= WINDOW_HEIGHT - BUTTON_HEIGHT - 20 &&
                         mouseY <= WINDOW_HEIGHT - 20);
     if (hoverBackSettings != prevHoverBackSettings && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     prevHoverBackSettings = hoverBackSettings;
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
@@ -2355,7 +2913,7 @@ void Game::handleSettingsEvents(SDL_Event& e) {
         if (mouseX >= soundCheckbox.x && mouseX <= soundCheckbox.x + checkboxSize && mouseY >= soundCheckbox.y && mouseY <= soundCheckbox.y + checkboxSize) {
             soundOn = !soundOn;
             int vol = soundOn ? effectsVolume * 128 / 100 : 0;
-            Mix_Volume(-1, vol);
+            VoiceManager::setVolume(vol);
             saveSettingsToFile();
             return;
         }
@@ -2366,7 +2924,7 @@ void Game::handleSettingsEvents(SDL_Event& e) {
             int relX = mouseX - sliderX;
             effectsVolume = (relX * 100) / (sliderWidth - knobWidth);
             effectsVolume = std::max(0, std::min(100, effectsVolume));
-            if (soundOn) Mix_Volume(-1, effectsVolume * 128 / 100);
+            if (soundOn) VoiceManager::setVolume(effectsVolume * 128 / 100);
             saveSettingsToFile();
             return;
         }
@@ -2399,7 +2957,7 @@ void Game::handleSettingsEvents(SDL_Event& e) {
             int relX = mouseX - sliderX;
             effectsVolume = (relX * 100) / (sliderWidth - knobWidth);
             effectsVolume = std::max(0, std::min(100, effectsVolume));
-            if (soundOn) Mix_Volume(-1, effectsVolume * 128 / 100);
+            if (soundOn) VoiceManager::setVolume(effectsVolume * 128 / 100);
             saveSettingsToFile();
         }
     }
@@ -2483,7 +3041,7 @@ void Game::handleStatsEvents(SDL_Event& e) {
                         mouseY >= WINDOW_HEIGHT - BUTTON_HEIGHT - 20 &&
                         mouseY <= WINDOW_HEIGHT - 20);
     if (hoverBackStats != prevHoverBackStats && buttonHoverSound) {
-        Mix_PlayChannel(-1, buttonHoverSound, 0);
+        VoiceManager::play(SoundId::BUTTON_HOVER, buttonHoverSound);
     }
     prevHoverBackStats = hoverBackStats;
     if (e.type == SDL_MOUSEBUTTONDOWN && e.button.button == SDL_BUTTON_LEFT) {
@@ -2554,7 +3112,9 @@ void Game::updateStatsAfterGameOver() {
         if (stats.score > highScore) highScore = stats.score;
         for (int i = 4; i > 0; --i) last5Scores[i] = last5Scores[i-1];
         last5Scores[0] = stats.score;
-        saveStatsToFile();
+        if (!headless) {
+            saveStatsToFile();
+        }
     }
 }
 
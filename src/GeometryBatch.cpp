@@ -0,0 +1,63 @@
+#include "GeometryBatch.h"
+
+#include <iostream>
+
+
+GeometryBatch::GeometryBatch(size_t reserveQuads) : quadCount(0) {
+    vertices.reserve(reserveQuads * 4);
+    indices.reserve(reserveQuads * 6);
+}
+
+void GeometryBatch::addRect(float x, float y, float w, float h, SDL_Color color) {
+    size_t base = quadCount * 4;
+    if (vertices.size() < base + 4) {
+        vertices.resize(base + 4);
+    }
+
+    SDL_Vertex* v = &vertices[base];
+    v[0].position = {x, y};
+    v[1].position = {x + w, y};
+    v[2].position = {x + w, y + h};
+    v[3].position = {x, y + h};
+    for (int i = 0; i < 4; ++i) {
+        v[i].color = color;
+        v[i].tex_coord = {0.0f, 0.0f};
+    }
+
+    ++quadCount;
+}
+
+size_t GeometryBatch::size() const {
+    return quadCount;
+}
+
+void GeometryBatch::clear() {
+    quadCount = 0;
+}
+
+void GeometryBatch::flush(SDL_Renderer* renderer) {
+    if (quadCount == 0) {
+        return;
+    }
+
+    // Extend the shared index pattern to cover every queued quad
+    while (indices.size() < quadCount * 6) {
+        int base = static_cast<int>(indices.size() / 6) * 4;
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    if (SDL_RenderGeometry(renderer, nullptr,
+                           vertices.data(), static_cast<int>(quadCount * 4),
+                           indices.data(), static_cast<int>(quadCount * 6)) != 0) {
+        cerr << "SDL_RenderGeometry failed: " << SDL_GetError() << endl;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    quadCount = 0;
+}
@@ -0,0 +1,164 @@
+#include "HudLayer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+
+HudLayer::HudLayer() : targetsSupported(true), textBuffer() {}
+
+HudLayer::~HudLayer() {
+    destroy();
+}
+
+int HudLayer::addLabel(int x, int y, const string& format, SDL_Color color, int value) {
+    // Split once here so painting never treats widget text as a format string
+    size_t marker = format.find("%d");
+    bool showsValue = marker != string::npos;
+    string prefix = showsValue ? format.substr(0, marker) : format;
+    string suffix = showsValue ? format.substr(marker + 2) : "";
+    HudWidget widget = {HudWidgetType::LABEL, {x, y, 0, 0}, color, prefix, suffix, showsValue,
+                        nullptr, nullptr, 0, 0, value, true, true};
+    widgets.push_back(widget);
+    return static_cast<int>(widgets.size()) - 1;
+}
+
+int HudLayer::addBar(int x, int y, int width, int height, SDL_Color color) {
+    HudWidget widget = {HudWidgetType::BAR, {x, y, width, height}, color, "", "", false, nullptr, nullptr, 0, 0, 0, true, true};
+    widgets.push_back(widget);
+    return static_cast<int>(widgets.size()) - 1;
+}
+
+int HudLayer::addPanel(int x, int y, int width, int height, function<void(SDL_Renderer*, int, int)> painter) {
+    HudWidget widget = {HudWidgetType::PANEL, {x, y, width, height}, {255, 255, 255, 255}, "", "", false, painter, nullptr, 0, 0, 0, true, true};
+    widgets.push_back(widget);
+    return static_cast<int>(widgets.size()) - 1;
+}
+
+void HudLayer::setValue(int id, int value) {
+    HudWidget& widget = widgets[id];
+    if (widget.value != value) {
+        widget.value = value;
+        widget.dirty = true;
+    }
+}
+
+void HudLayer::setBarFill(int id, float percentage) {
+    const HudWidget& widget = widgets[id];
+    percentage = max(0.0f, min(percentage, 1.0f));
+    setValue(id, static_cast<int>(widget.rect.w * percentage));
+}
+
+void HudLayer::setVisible(int id, bool visible) {
+    widgets[id].visible = visible;
+}
+
+const char* HudLayer::formatLabel(const HudWidget& widget) {
+    if (widget.showsValue) {
+        snprintf(textBuffer, sizeof(textBuffer), "%s%d%s", widget.prefix.c_str(), widget.value, widget.suffix.c_str());
+    } else {
+        snprintf(textBuffer, sizeof(textBuffer), "%s", widget.prefix.c_str());
+    }
+    return textBuffer;
+}
+
+void HudLayer::paint(SDL_Renderer* renderer, TextRenderer& textRenderer, HudWidget& widget, int originX, int originY) {
+    switch (widget.type) {
+        case HudWidgetType::LABEL:
+            textRenderer.draw(renderer, formatLabel(widget), originX, originY, widget.color);
+            break;
+
+        case HudWidgetType::BAR: {
+            SDL_SetRenderDrawColor(renderer, 50, 50, 50, 255);
+            SDL_Rect bgRect = {originX, originY, widget.rect.w, widget.rect.h};
+            SDL_RenderFillRect(renderer, &bgRect);
+
+            SDL_SetRenderDrawColor(renderer, widget.color.r, widget.color.g, widget.color.b, widget.color.a);
+            SDL_Rect fillRect = {originX, originY, widget.value, widget.rect.h};
+            SDL_RenderFillRect(renderer, &fillRect);
+            break;
+        }
+
+        case HudWidgetType::PANEL:
+            widget.painter(renderer, originX, originY);
+            break;
+    }
+}
+
+bool HudLayer::prepareTexture(SDL_Renderer* renderer, HudWidget& widget) {
+    if (widget.texture && widget.textureWidth >= widget.rect.w && widget.textureHeight >= widget.rect.h) {
+        return true;
+    }
+
+    if (widget.texture) {
+        SDL_DestroyTexture(widget.texture);
+    }
+
+    // Round labels up so a growing number does not reallocate every time
+    widget.textureWidth = widget.type == HudWidgetType::LABEL ? (widget.rect.w + 63) / 64 * 64 : widget.rect.w;
+    widget.textureHeight = widget.rect.h;
+    widget.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                       max(1, widget.textureWidth), max(1, widget.textureHeight));
+    if (!widget.texture) {
+        return false;
+    }
+    SDL_SetTextureBlendMode(widget.texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void HudLayer::render(SDL_Renderer* renderer, TextRenderer& textRenderer) {
+    if (!SDL_RenderTargetSupported(renderer)) {
+        targetsSupported = false;
+    }
+
+    for (auto& widget : widgets) {
+        if (!widget.visible) {
+            continue;
+        }
+
+        if (widget.type == HudWidgetType::LABEL && widget.dirty) {
+            const char* text = formatLabel(widget);
+            widget.rect.w = textRenderer.textWidth(text);
+            widget.rect.h = textRenderer.textHeight();
+        }
+
+        // Without render targets there is nothing to cache into
+        if (!targetsSupported) {
+            paint(renderer, textRenderer, widget, widget.rect.x, widget.rect.y);
+            continue;
+        }
+
+        if (widget.dirty) {
+            if (!prepareTexture(renderer, widget)) {
+                paint(renderer, textRenderer, widget, widget.rect.x, widget.rect.y);
+                continue;
+            }
+
+            SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+            SDL_SetRenderTarget(renderer, widget.texture);
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+            SDL_RenderClear(renderer);
+            paint(renderer, textRenderer, widget, 0, 0);
+            SDL_SetRenderTarget(renderer, previousTarget);
+            widget.dirty = false;
+        }
+
+        SDL_Rect src = {0, 0, widget.rect.w, widget.rect.h};
+        SDL_RenderCopy(renderer, widget.texture, &src, &widget.rect);
+    }
+}
+
+void HudLayer::invalidate() {
+    for (auto& widget : widgets) {
+        widget.dirty = true;
+    }
+}
+
+void HudLayer::destroy() {
+    for (auto& widget : widgets) {
+        if (widget.texture) {
+            SDL_DestroyTexture(widget.texture);
+            widget.texture = nullptr;
+        }
+    }
+    widgets.clear();
+}
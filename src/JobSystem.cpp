@@ -0,0 +1,191 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+
+vector<SDL_Thread*> JobSystem::workers;
+vector<JobSystem::BatchRange> JobSystem::ranges;
+SDL_mutex* JobSystem::mutex = nullptr;
+SDL_cond* JobSystem::wakeCond = nullptr;
+SDL_cond* JobSystem::doneCond = nullptr;
+Uint32 JobSystem::generation = 0;
+int JobSystem::busyWorkers = 0;
+bool JobSystem::quitting = false;
+const BatchJob* JobSystem::currentJob = nullptr;
+int JobSystem::currentCount = 0;
+int JobSystem::currentBatchSize = 1;
+
+void JobSystem::init(int threads) {
+    if (mutex) {
+        return;
+    }
+
+    if (threads <= 0) {
+        threads = SDL_GetCPUCount();
+    }
+    if (threads <= 1) {
+        return;
+    }
+
+    mutex = SDL_CreateMutex();
+    wakeCond = SDL_CreateCond();
+    doneCond = SDL_CreateCond();
+    if (!mutex || !wakeCond || !doneCond) {
+        cerr << "Unable to create job system locks! SDL_Error: " << SDL_GetError() << endl;
+        shutdown();
+        return;
+    }
+
+    for (int i = 0; i < threads - 1; ++i) {
+        SDL_Thread* worker = SDL_CreateThread(workerMain, "JobWorker", reinterpret_cast<void*>(static_cast<intptr_t>(i)));
+        if (!worker) {
+            cerr << "Unable to start job thread! SDL_Error: " << SDL_GetError() << endl;
+            break;
+        }
+        workers.push_back(worker);
+    }
+
+    // Workers only look at the ranges once woken by the first parallelFor
+    ranges.assign(workers.size() + 1, {0, 0, 0});
+}
+
+void JobSystem::shutdown() {
+    if (mutex) {
+        SDL_LockMutex(mutex);
+        quitting = true;
+        SDL_CondBroadcast(wakeCond);
+        SDL_UnlockMutex(mutex);
+    }
+    for (SDL_Thread* worker : workers) {
+        SDL_WaitThread(worker, nullptr);
+    }
+    workers.clear();
+    ranges.clear();
+
+    if (doneCond) {
+        SDL_DestroyCond(doneCond);
+        doneCond = nullptr;
+    }
+    if (wakeCond) {
+        SDL_DestroyCond(wakeCond);
+        wakeCond = nullptr;
+    }
+    if (mutex) {
+        SDL_DestroyMutex(mutex);
+        mutex = nullptr;
+    }
+    quitting = false;
+}
+
+int JobSystem::threadCount() {
+    return static_cast<int>(workers.size()) + 1;
+}
+
+int JobSystem::batchCount(int count, int batchSize) {
+    return count > 0 ? (count + batchSize - 1) / batchSize : 0;
+}
+
+void JobSystem::parallelFor(int count, int batchSize, const BatchJob& job) {
+    int batches = batchCount(count, batchSize);
+    if (batches == 0) {
+        return;
+    }
+
+    // Waking the workers costs more than a single batch saves
+    if (workers.empty() || batches == 1) {
+        for (int batch = 0; batch < batches; ++batch) {
+            job(batch * batchSize, min(count, (batch + 1) * batchSize), batch);
+        }
+        return;
+    }
+
+    int threads = static_cast<int>(ranges.size());
+    for (int t = 0; t < threads; ++t) {
+        ranges[t].next = batches * t / threads;
+        ranges[t].end = batches * (t + 1) / threads;
+    }
+    currentJob = &job;
+    currentCount = count;
+    currentBatchSize = batchSize;
+
+    SDL_LockMutex(mutex);
+    busyWorkers = static_cast<int>(workers.size());
+    generation++;
+    SDL_CondBroadcast(wakeCond);
+    SDL_UnlockMutex(mutex);
+
+    runBatches(threads - 1);
+
+    // Every worker checks in, so none still holds the job once this returns
+    SDL_LockMutex(mutex);
+    while (busyWorkers > 0) {
+        SDL_CondWait(doneCond, mutex);
+    }
+    SDL_UnlockMutex(mutex);
+    currentJob = nullptr;
+}
+
+int JobSystem::workerMain(void* data) {
+    int self = static_cast<int>(reinterpret_cast<intptr_t>(data));
+    Uint32 seen = 0;
+
+    SDL_LockMutex(mutex);
+    while (true) {
+        while (!quitting && generation == seen) {
+            SDL_CondWait(wakeCond, mutex);
+        }
+        if (quitting) {
+            break;
+        }
+        seen = generation;
+        SDL_UnlockMutex(mutex);
+
+        runBatches(self);
+
+        SDL_LockMutex(mutex);
+        if (--busyWorkers == 0) {
+            SDL_CondSignal(doneCond);
+        }
+    }
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+bool JobSystem::takeBatch(int self, int& batch) {
+    // Own run first, front to back, so neighbouring batches stay on one core
+    BatchRange& own = ranges[self];
+    SDL_AtomicLock(&own.lock);
+    bool found = own.next < own.end;
+    if (found) {
+        batch = own.next++;
+    }
+    SDL_AtomicUnlock(&own.lock);
+    if (found) {
+        return true;
+    }
+
+    // Then steal from the back of the others' runs
+    int threads = static_cast<int>(ranges.size());
+    for (int offset = 1; offset < threads; ++offset) {
+        BatchRange& victim = ranges[(self + offset) % threads];
+        SDL_AtomicLock(&victim.lock);
+        found = victim.next < victim.end;
+        if (found) {
+            batch = --victim.end;
+        }
+        SDL_AtomicUnlock(&victim.lock);
+        if (found) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::runBatches(int self) {
+    int batch;
+    while (takeBatch(self, batch)) {
+        int begin = batch * currentBatchSize;
+        (*currentJob)(begin, min(currentCount, begin + currentBatchSize), batch);
+    }
+}
@@ -2,14 +2,14 @@
 
 #include "Constants.h"
 
-KillNotification::KillNotification(const string& text_) : text(text_), startTime(SDL_GetTicks()), active(true) {}
+KillNotification::KillNotification(const string& text_, Uint32 currentTime)
+    : text(text_), startTime(currentTime), active(true) {}
 
-bool KillNotification::update() {
+bool KillNotification::update(Uint32 currentTime) {
     if (!active) {
         return false;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
     if (currentTime - startTime >= KILL_NOTIFICATION_DURATION) {
         active = false;
         return false;
@@ -17,35 +17,16 @@ bool KillNotification::update() {
     return true;
 }
 
-void KillNotification::render(SDL_Renderer* renderer, TTF_Font* font) {
+void KillNotification::render(SDL_Renderer* renderer, TextRenderer& textRenderer, Uint32 currentTime) {
     if (!active) {
         return;
     }
 
-    Uint32 currentTime = SDL_GetTicks();
     float progress = (currentTime - startTime) / static_cast<float>(KILL_NOTIFICATION_DURATION);
 
     // Fade out near the end
     Uint8 alpha = progress > 0.7f ? static_cast<Uint8>(255 * (1.0f - (progress - 0.7f) / 0.3f)) : 255;
 
     SDL_Color textColor = {255, 0, 0, alpha};
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), textColor);
-    if (!textSurface) {
-        return;
-    }
-
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    SDL_SetTextureAlphaMod(textTexture, alpha);
-
-    SDL_Rect textRect = {
-        WINDOW_WIDTH / 2 - textSurface->w / 2,
-        50,
-        textSurface->w,
-        textSurface->h
-    };
-
-    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    textRenderer.draw(renderer, text, WINDOW_WIDTH / 2 - textRenderer.textWidth(text) / 2, 50, textColor);
 }
\ No newline at end of file
@@ -1,107 +1,168 @@
 #include "ParticleSystem.h"
 
 #include <cmath>
-#include <random>
-#include <chrono>
+#include <algorithm>
 
 #include "Constants.h"
 
 using namespace std;
 
-ParticleSystem::ParticleSystem(int maxParticles) {
-    particles.resize(maxParticles);
-    for (auto& p : particles) {
-        p.active = false;
+ParticleSystem::ParticleSystem(int maxParticles, ParticleOverflow policy)
+    : liveCount(0), recycleCursor(0), overflowPolicy(policy), rng(&ownRng) {
+    particles.resize(max(1, maxParticles));
+    stats = {0, 0, 0, 0};
+}
+
+Particle* ParticleSystem::allocate(bool& saturated) {
+    if (liveCount < particles.size()) {
+        return &particles[liveCount++];
+    }
+
+    if (!saturated) {
+        saturated = true;
+        stats.saturations++;
+    }
+
+    switch (overflowPolicy) {
+        case ParticleOverflow::RECYCLE_OLDEST:
+            // Round-robin over the live particles: an O(1) stand-in for
+            // oldest-first, which would need a scan or an age-ordered pool
+            stats.recycled++;
+            recycleCursor = (recycleCursor + 1) % particles.size();
+            return &particles[recycleCursor];
+
+        case ParticleOverflow::GROW:
+            stats.grown++;
+            particles.resize(particles.size() * 2);
+            return &particles[liveCount++];
+
+        case ParticleOverflow::DROP:
+        default:
+            stats.dropped++;
+            return nullptr;
     }
 }
 
-void ParticleSystem::emit(float x, float y, float angle, int count, SDL_Color color, int life) {
-    uniform_real_distribution<float> angleDist(-0.5f, 0.5f);
-    uniform_real_distribution<float> speedDist(0.5f, 2.0f);
-    uniform_int_distribution<int> lifeDist(life / 2, life);
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
+void ParticleSystem::emit(float x, float y, float angle, int count, SDL_Color color, float life) {
 
+    bool saturated = false;
     for (int i = 0; i < count; ++i) {
-        // Find inactive particle
-        for (auto& p : particles) {
-            if (!p.active) {
-                p.x = x;
-                p.y = y;
-                float particleAngle = angle + angleDist(rng);
-                float speed = speedDist(rng);
-                p.vx = cos(particleAngle) * speed;
-                p.vy = sin(particleAngle) * speed;
-                p.life = lifeDist(rng);
-                p.maxLife = p.life;
-                p.color = color;
-                p.active = true;
-                break;
-            }
+        Particle* p = allocate(saturated);
+        if (!p) {
+            stats.dropped += count - i - 1;
+            break;
         }
+
+        p->x = x;
+        p->y = y;
+        float particleAngle = angle + rng->uniform(-0.5f, 0.5f);
+        float speed = rng->uniform(0.5f, 2.0f);
+        p->vx = cos(particleAngle) * speed;
+        p->vy = sin(particleAngle) * speed;
+        p->life = rng->uniform(life * 0.5f, life);
+        p->maxLife = p->life;
+        p->color = color;
     }
 }
 
-void ParticleSystem::emitCircle(float x, float y, float radius, int count, SDL_Color color, int life) {
-    uniform_real_distribution<float> angleDist(0, 2 * M_PI);
-    uniform_real_distribution<float> radiusDist(0.8f * radius, 1.2f * radius);
-    uniform_real_distribution<float> speedDist(0.2f, 0.8f);
-    uniform_int_distribution<int> lifeDist(life / 2, life);
-    mt19937 rng(chrono::steady_clock::now().time_since_epoch().count());
+void ParticleSystem::emitCircle(float x, float y, float radius, int count, SDL_Color color, float life) {
 
+    bool saturated = false;
     for (int i = 0; i < count; ++i) {
-        for (auto& p : particles) {
-            if (!p.active) {
-                float angle = angleDist(rng);
-                float particleRadius = radiusDist(rng);
-                p.x = x + cos(angle) * particleRadius;
-                p.y = y + sin(angle) * particleRadius;
-
-                float speed = speedDist(rng);
-                p.vx = cos(angle) * speed;
-                p.vy = sin(angle) * speed;
-
-                p.life = lifeDist(rng);
-                p.maxLife = p.life;
-                p.color = color;
-                p.active = true;
-                break;
-            }
+        Particle* p = allocate(saturated);
+        if (!p) {
+            stats.dropped += count - i - 1;
+            break;
         }
+
+        float angle = rng->uniform(0, 2 * M_PI);
+        float particleRadius = rng->uniform(0.8f * radius, 1.2f * radius);
+        p->x = x + cos(angle) * particleRadius;
+        p->y = y + sin(angle) * particleRadius;
+
+        float speed = rng->uniform(0.2f, 0.8f);
+        p->vx = cos(angle) * speed;
+        p->vy = sin(angle) * speed;
+
+        p->life = rng->uniform(life * 0.5f, life);
+        p->maxLife = p->life;
+        p->color = color;
     }
 }
 
-void ParticleSystem::update() {
-    for (auto& p : particles) {
-        if (p.active) {
-            p.x += p.vx;
-            p.y += p.vy;
-            p.life--;
-            if (p.life <= 0) {
-                p.active = false;
-            }
+void ParticleSystem::update(float deltaTime) {
+    // Velocities are per 1/60 s step, as for tanks and bullets
+    const float step = deltaTime * 60.0f;
+    size_t i = 0;
+    while (i < liveCount) {
+        Particle& p = particles[i];
+        p.x += p.vx * step;
+        p.y += p.vy * step;
+        p.life -= deltaTime;
+        if (p.life <= 0) {
+            // Swap-on-death keeps the live particles packed; the moved-in
+            // particle is updated on the next pass through this slot
+            p = particles[--liveCount];
+            continue;
         }
+        ++i;
     }
 }
 
-void ParticleSystem::render(SDL_Renderer* renderer, float cameraX, float cameraY) {
-    for (const auto& p : particles) {
-        if (p.active) {
-            float alpha = static_cast<float>(p.life) / p.maxLife;
-            SDL_SetRenderDrawColor(
-                renderer,
-                p.color.r,
-                p.color.g,
-                p.color.b,
-                static_cast<Uint8>(255 * alpha)
-            );
-
-            SDL_Rect rect = {
-                static_cast<int>(p.x - cameraX),
-                static_cast<int>(p.y - cameraY),
-                2,
-                2
-            };
-            SDL_RenderFillRect(renderer, &rect);
+int ParticleSystem::cull(const SDL_FRect& view, vector<int>& visible) const {
+    visible.clear();
+    for (size_t i = 0; i < liveCount; ++i) {
+        if (overlapsView(particles[i].x + 1.0f, particles[i].y + 1.0f, 1.0f, view)) {
+            visible.push_back(static_cast<int>(i));
         }
     }
+    return static_cast<int>(liveCount - visible.size());
+}
+
+void ParticleSystem::render(GeometryBatch& batch, const vector<int>& visible, float cameraX, float cameraY) {
+    for (int i : visible) {
+        const Particle& p = particles[i];
+        float alpha = p.life / p.maxLife;
+        SDL_Color color = {p.color.r, p.color.g, p.color.b, static_cast<Uint8>(255 * alpha)};
+        batch.addRect(
+            static_cast<float>(static_cast<int>(p.x - cameraX)),
+            static_cast<float>(static_cast<int>(p.y - cameraY)),
+            2.0f,
+            2.0f,
+            color
+        );
+    }
+}
+
+void ParticleSystem::clear() {
+    liveCount = 0;
+}
+
+void ParticleSystem::copyForRender(const ParticleSystem& source) {
+    // The source may have grown past this pool's size
+    if (particles.size() < source.liveCount) {
+        particles.resize(source.liveCount);
+    }
+    copy_n(source.particles.begin(), source.liveCount, particles.begin());
+    liveCount = source.liveCount;
+}
+
+void ParticleSystem::setRng(Rng* rng_) {
+    rng = rng_ ? rng_ : &ownRng;
+}
+
+void ParticleSystem::setOverflowPolicy(ParticleOverflow policy) {
+    overflowPolicy = policy;
+}
+
+size_t ParticleSystem::liveParticles() const {
+    return liveCount;
+}
+
+size_t ParticleSystem::capacity() const {
+    return particles.size();
+}
+
+const ParticlePoolStats& ParticleSystem::getStats() const {
+    return stats;
 }
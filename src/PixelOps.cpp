@@ -0,0 +1,147 @@
+#include "PixelOps.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PIXELOPS_X86 1
+#include <immintrin.h>
+#endif
+
+// Lets GCC/Clang emit SSE2/AVX2 for one function without -m flags on the
+// whole build; which one runs is decided at runtime
+#if defined(__GNUC__) || defined(__clang__)
+#define PIXELOPS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define PIXELOPS_TARGET(isa)
+#endif
+
+namespace {
+
+// x / 255 rounded down, exact for x in [0, 255 * 255]
+inline Uint32 div255(Uint32 x) {
+    return ((x + 1) * 257) >> 16;
+}
+
+void tintScalar(Uint32* pixels, int count, Uint8 r, Uint8 g, Uint8 b) {
+    // RGBA32 is R, G, B, A in memory on every platform
+    Uint8* bytes = reinterpret_cast<Uint8*>(pixels);
+    for (int i = 0; i < count; ++i, bytes += 4) {
+        if (bytes[3] == 0) {
+            continue;
+        }
+        bytes[0] = static_cast<Uint8>(div255(bytes[0] * r));
+        bytes[1] = static_cast<Uint8>(div255(bytes[1] * g));
+        bytes[2] = static_cast<Uint8>(div255(bytes[2] * b));
+    }
+}
+
+#ifdef PIXELOPS_X86
+
+// Both SIMD kernels widen each channel to 16 bits, multiply by the tint
+// (255 for alpha, which leaves it unchanged), divide by 255 with
+// mulhi((x + 1), 257) and keep the source pixel wherever alpha is zero.
+
+PIXELOPS_TARGET("sse2")
+int tintSSE2(Uint32* pixels, int count, Uint8 r, Uint8 g, Uint8 b) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i k257 = _mm_set1_epi16(257);
+    const __m128i tint = _mm_setr_epi16(r, g, b, 255, r, g, b, 255);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i* p = reinterpret_cast<__m128i*>(pixels + i);
+        __m128i src = _mm_loadu_si128(p);
+
+        __m128i lo = _mm_unpacklo_epi8(src, zero);
+        __m128i hi = _mm_unpackhi_epi8(src, zero);
+        lo = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(lo, tint), one), k257);
+        hi = _mm_mulhi_epu16(_mm_add_epi16(_mm_mullo_epi16(hi, tint), one), k257);
+        __m128i tinted = _mm_packus_epi16(lo, hi);
+
+        __m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(src, alphaMask), zero);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_and_si128(transparent, src),
+                                         _mm_andnot_si128(transparent, tinted)));
+    }
+    return i;
+}
+
+PIXELOPS_TARGET("avx2")
+int tintAVX2(Uint32* pixels, int count, Uint8 r, Uint8 g, Uint8 b) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i one = _mm256_set1_epi16(1);
+    const __m256i k257 = _mm256_set1_epi16(257);
+    const __m256i tint = _mm256_setr_epi16(r, g, b, 255, r, g, b, 255,
+                                           r, g, b, 255, r, g, b, 255);
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i* p = reinterpret_cast<__m256i*>(pixels + i);
+        __m256i src = _mm256_loadu_si256(p);
+
+        // Unpack and pack both work within 128-bit lanes, so pixel order survives
+        __m256i lo = _mm256_unpacklo_epi8(src, zero);
+        __m256i hi = _mm256_unpackhi_epi8(src, zero);
+        lo = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(lo, tint), one), k257);
+        hi = _mm256_mulhi_epu16(_mm256_add_epi16(_mm256_mullo_epi16(hi, tint), one), k257);
+        __m256i tinted = _mm256_packus_epi16(lo, hi);
+
+        __m256i transparent = _mm256_cmpeq_epi32(_mm256_and_si256(src, alphaMask), zero);
+        _mm256_storeu_si256(p, _mm256_blendv_epi8(tinted, src, transparent));
+    }
+    return i;
+}
+
+#endif // PIXELOPS_X86
+
+PixelKernel bestKernel() {
+    static const PixelKernel best = pixelKernelSupported(PixelKernel::AVX2) ? PixelKernel::AVX2
+                                  : pixelKernelSupported(PixelKernel::SSE2) ? PixelKernel::SSE2
+                                  : PixelKernel::SCALAR;
+    return best;
+}
+
+} // namespace
+
+void tintPixelsRGBA32(Uint32* pixels, int count, Uint8 r, Uint8 g, Uint8 b, PixelKernel kernel) {
+    if (kernel == PixelKernel::AUTO || !pixelKernelSupported(kernel)) {
+        kernel = bestKernel();
+    }
+
+    // SIMD kernels return how many pixels they did; the scalar loop finishes the tail
+    int done = 0;
+#ifdef PIXELOPS_X86
+    if (kernel == PixelKernel::AVX2) {
+        done = tintAVX2(pixels, count, r, g, b);
+    } else if (kernel == PixelKernel::SSE2) {
+        done = tintSSE2(pixels, count, r, g, b);
+    }
+#endif
+    tintScalar(pixels + done, count - done, r, g, b);
+}
+
+bool pixelKernelSupported(PixelKernel kernel) {
+    switch (kernel) {
+        case PixelKernel::AUTO:
+        case PixelKernel::SCALAR:
+            return true;
+#ifdef PIXELOPS_X86
+        case PixelKernel::SSE2:
+            return SDL_HasSSE2() == SDL_TRUE;
+        case PixelKernel::AVX2:
+            return SDL_HasAVX2() == SDL_TRUE;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* pixelKernelName(PixelKernel kernel) {
+    switch (kernel) {
+        case PixelKernel::AUTO: return "auto";
+        case PixelKernel::SCALAR: return "scalar";
+        case PixelKernel::SSE2: return "sse2";
+        case PixelKernel::AVX2: return "avx2";
+    }
+    return "unknown";
+}
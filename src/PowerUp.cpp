@@ -4,54 +4,47 @@
 
 #include "ResourceManager.h"
 
-PowerUp::PowerUp(float x_, float y_, PowerUpType type_)
-    : x(x_), y(y_), active(true), type(type_), spawnTime(SDL_GetTicks()) {
+PowerUp::PowerUp(float x_, float y_, PowerUpType type_, Uint32 currentTime)
+    : x(x_), y(y_), active(true), type(type_), spawnTime(currentTime) {
     if (type_ == PowerUpType::HEALTH_PICKUP) {
-        texture = ResourceManager::getTexture("assets/images/item/health_pickup.png");
+        texture = ResourceManager::textureHandle(TextureId::HEALTH_PICKUP);
     } else {
-        texture = ResourceManager::getTexture("assets/images/item/powerup.png");
+        texture = ResourceManager::textureHandle(TextureId::POWERUP);
     }
 }
 
-void PowerUp::render(SDL_Renderer* renderer, float cameraX, float cameraY) {
+void PowerUp::render(SpriteBatch& batch, float cameraX, float cameraY, Uint32 currentTime) {
     if (!active) {
         return;
     }
 
     // Make power-up pulse
-    Uint32 currentTime = SDL_GetTicks();
     float scale = 1.0f + 0.1f * sin((currentTime - spawnTime) / 200.0f);
 
     int size = static_cast<int>(30 * scale);
-    SDL_Rect destRect = {
-        static_cast<int>(x - size / 2 - cameraX),
-        static_cast<int>(y - size / 2 - cameraY),
-        size,
-        size
+    SDL_FRect destRect = {
+        static_cast<float>(static_cast<int>(x - size / 2 - cameraX)),
+        static_cast<float>(static_cast<int>(y - size / 2 - cameraY)),
+        static_cast<float>(size),
+        static_cast<float>(size)
     };
 
-
-    if (type == PowerUpType::HEALTH_PICKUP) {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255); 
-    } else {
-        SDL_SetRenderDrawColor(
-            renderer,
-            type == PowerUpType::HEALTH ? 255 : 0,
-            type == PowerUpType::SPEED ? 255 : 0,
-            type == PowerUpType::DAMAGE ? 255 : 0,
-            255
-        );
-    }
-
-    if (texture) {
+    if (texture.ready()) {
+        // Health pickups have their own art, reddened through the vertex colour
+        SDL_Color tint = {255, 255, 255, 255};
         if (type == PowerUpType::HEALTH_PICKUP) {
-            SDL_SetTextureColorMod(texture, 255, 100, 100);
-        } else {
-            SDL_SetTextureColorMod(texture, 255, 255, 255);
+            tint = {255, 100, 100, 255};
         }
-
-        SDL_RenderCopy(renderer, texture, nullptr, &destRect);
+        batch.add(texture.texture(), texture.rect(), destRect, 0.0f, tint);
+    } else if (type == PowerUpType::HEALTH_PICKUP) {
+        batch.add(nullptr, nullptr, destRect, 0.0f, {255, 0, 0, 255});
     } else {
-        SDL_RenderFillRect(renderer, &destRect);
+        SDL_Color color = {
+            static_cast<Uint8>(type == PowerUpType::HEALTH ? 255 : 0),
+            static_cast<Uint8>(type == PowerUpType::SPEED ? 255 : 0),
+            static_cast<Uint8>(type == PowerUpType::DAMAGE ? 255 : 0),
+            255
+        };
+        batch.add(nullptr, nullptr, destRect, 0.0f, color);
     }
 }
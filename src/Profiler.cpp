@@ -0,0 +1,318 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+#include "Constants.h"
+#include "TextRenderer.h"
+
+namespace {
+
+const char* const ZONE_NAMES[PROFILE_ZONE_COUNT] = {
+    "frame", "events", "loading", "update", "player", "ai", "bullets", "particles",
+    "collisions", "cleanup", "render", "world", "hud", "minimap", "present"
+};
+
+const char* const COUNTER_NAMES[PROFILE_COUNTER_COUNT] = {
+    "enemies", " culled", "bullets", " culled", "particles", " culled",
+    "powerups", " culled", "explosions", " culled"
+};
+
+// Indentation in the overlay, mirroring how the zones nest
+const int ZONE_DEPTH[PROFILE_ZONE_COUNT] = {
+    0, 1, 1, 1, 2, 2, 2, 2, 2, 2, 1, 2, 2, 2, 2
+};
+
+double ticksToMs(Uint64 ticks) {
+    return ticks * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+} // namespace
+
+SDL_SpinLock Profiler::lock = 0;
+SDL_atomic_t Profiler::enabled = {0};
+bool Profiler::forcedOn = false;
+bool Profiler::overlayVisible = false;
+Uint64 Profiler::frameStart = 0;
+Profiler::FrameRecord Profiler::current = {};
+vector<Profiler::FrameRecord> Profiler::history;
+int Profiler::historyNext = 0;
+int Profiler::historyCount = 0;
+
+bool Profiler::capturing = false;
+int Profiler::captureFramesLeft = 0;
+Uint64 Profiler::captureStart = 0;
+vector<Profiler::TraceEvent> Profiler::traceEvents;
+string Profiler::capturePath;
+
+ProfileZoneStats Profiler::cachedStats[PROFILE_ZONE_COUNT] = {};
+double Profiler::cachedCounters[PROFILE_COUNTER_COUNT] = {};
+Uint64 Profiler::lastStatsUpdate = 0;
+
+const char* Profiler::zoneName(ProfileZone zone) {
+    return ZONE_NAMES[static_cast<int>(zone)];
+}
+
+const char* Profiler::counterName(ProfileCounter counter) {
+    return COUNTER_NAMES[static_cast<int>(counter)];
+}
+
+void Profiler::beginFrame() {
+    if (!SDL_AtomicGet(&enabled)) {
+        return;
+    }
+
+    frameStart = SDL_GetPerformanceCounter();
+    SDL_AtomicLock(&lock);
+    current = {};
+
+    // A capture requested during the last frame starts on a frame boundary
+    if (captureFramesLeft > 0 && !capturing) {
+        capturing = true;
+        captureStart = frameStart;
+        traceEvents.clear();
+    }
+    SDL_AtomicUnlock(&lock);
+}
+
+void Profiler::endFrame() {
+    if (!SDL_AtomicGet(&enabled) || frameStart == 0) {
+        return;
+    }
+
+    record(ProfileZone::FRAME, frameStart, SDL_GetPerformanceCounter());
+    frameStart = 0;
+
+    if (history.empty()) {
+        history.resize(PROFILER_HISTORY_FRAMES);
+    }
+    SDL_AtomicLock(&lock);
+    history[historyNext] = current;
+    bool captureDone = capturing && --captureFramesLeft == 0;
+    if (captureDone) {
+        // From here on no thread adds events, so the file can be written unlocked
+        capturing = false;
+    }
+    SDL_AtomicUnlock(&lock);
+    historyNext = (historyNext + 1) % PROFILER_HISTORY_FRAMES;
+    historyCount = min(historyCount + 1, PROFILER_HISTORY_FRAMES);
+
+    if (captureDone) {
+        if (writeChromeTrace(capturePath)) {
+            cout << "Wrote profiler trace " << capturePath << endl;
+        }
+        traceEvents.clear();
+        updateEnabled();
+    }
+}
+
+void Profiler::record(ProfileZone zone, Uint64 start, Uint64 end) {
+    int index = static_cast<int>(zone);
+    SDL_AtomicLock(&lock);
+    current.ticks[index] += end - start;
+    current.calls[index]++;
+
+    if (capturing) {
+        traceEvents.push_back({zone, start, end, SDL_ThreadID()});
+    }
+    SDL_AtomicUnlock(&lock);
+}
+
+void Profiler::count(ProfileCounter counter, int amount) {
+    if (!SDL_AtomicGet(&enabled)) {
+        return;
+    }
+    SDL_AtomicLock(&lock);
+    current.counters[static_cast<int>(counter)] += amount;
+    SDL_AtomicUnlock(&lock);
+}
+
+void Profiler::updateEnabled() {
+    bool enable = forcedOn || overlayVisible || captureFramesLeft > 0;
+    bool wasEnabled = SDL_AtomicSet(&enabled, enable ? 1 : 0) != 0;
+
+    // Start from a clean window so stale frames do not skew the numbers
+    if (enable && !wasEnabled) {
+        historyNext = 0;
+        historyCount = 0;
+        lastStatsUpdate = 0;
+    }
+}
+
+void Profiler::toggleOverlay() {
+    overlayVisible = !overlayVisible;
+    updateEnabled();
+}
+
+bool Profiler::isOverlayVisible() {
+    return overlayVisible;
+}
+
+void Profiler::startCapture(const string& path, int frameCount) {
+    if (captureFramesLeft > 0 || frameCount <= 0) {
+        return;
+    }
+    capturePath = path;
+    captureFramesLeft = frameCount;
+    traceEvents.reserve(frameCount * PROFILE_ZONE_COUNT * 2);
+    updateEnabled();
+}
+
+bool Profiler::isCapturing() {
+    return captureFramesLeft > 0;
+}
+
+void Profiler::setEnabled(bool enable) {
+    forcedOn = enable;
+    updateEnabled();
+}
+
+ProfileZoneStats Profiler::zoneStats(ProfileZone zone) {
+    ProfileZoneStats result = {0.0, 0.0, 0.0, 0};
+    if (historyCount == 0) {
+        return result;
+    }
+
+    int index = static_cast<int>(zone);
+    vector<double> samples(historyCount);
+    double total = 0.0;
+    long long calls = 0;
+    for (int i = 0; i < historyCount; ++i) {
+        samples[i] = ticksToMs(history[i].ticks[index]);
+        total += samples[i];
+        calls += history[i].calls[index];
+    }
+
+    // Nearest-rank percentiles
+    auto percentile = [&samples](double p) {
+        size_t rank = static_cast<size_t>(ceil(p * samples.size()));
+        size_t nth = rank > 0 ? rank - 1 : 0;
+        nth_element(samples.begin(), samples.begin() + nth, samples.end());
+        return samples[nth];
+    };
+
+    result.average = total / historyCount;
+    result.p95 = percentile(0.95);
+    result.p99 = percentile(0.99);
+    result.calls = static_cast<int>((calls + historyCount / 2) / historyCount);
+    return result;
+}
+
+double Profiler::counterAverage(ProfileCounter counter) {
+    if (historyCount == 0) {
+        return 0.0;
+    }
+
+    int index = static_cast<int>(counter);
+    long long total = 0;
+    for (int i = 0; i < historyCount; ++i) {
+        total += history[i].counters[index];
+    }
+    return static_cast<double>(total) / historyCount;
+}
+
+void Profiler::renderOverlay(SDL_Renderer* renderer, TextRenderer& textRenderer) {
+    // Refresh twice a second; rebuilding every frame would make it unreadable
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastStatsUpdate == 0 || now - lastStatsUpdate >= SDL_GetPerformanceFrequency() / 2) {
+        for (int i = 0; i < PROFILE_ZONE_COUNT; ++i) {
+            cachedStats[i] = zoneStats(static_cast<ProfileZone>(i));
+        }
+        for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+            cachedCounters[i] = counterAverage(static_cast<ProfileCounter>(i));
+        }
+        lastStatsUpdate = now;
+    }
+
+    const int lineHeight = textRenderer.textHeight();
+    const int width = textRenderer.textWidth("collisions   00.00  00.00  00.00  00") + 20;
+    const int height = lineHeight * (PROFILE_ZONE_COUNT + PROFILE_COUNTER_COUNT + 2) + 20;
+    const int x = WINDOW_WIDTH - width - 10;
+    const int y = 10;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 190);
+    SDL_Rect panel = {x, y, width, height};
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_Color headerColor = {255, 220, 0, 255};
+    SDL_Color rowColor = {255, 255, 255, 255};
+    char line[64];
+
+    snprintf(line, sizeof(line), "%-12s %6s %6s %6s %3s", "ms", "avg", "p95", "p99", "n");
+    textRenderer.draw(renderer, line, x + 10, y + 10, headerColor);
+
+    for (int i = 0; i < PROFILE_ZONE_COUNT; ++i) {
+        const ProfileZoneStats& zone = cachedStats[i];
+        string name = string(ZONE_DEPTH[i], ' ') + ZONE_NAMES[i];
+        snprintf(line, sizeof(line), "%-12s %6.2f %6.2f %6.2f %3d",
+                 name.c_str(), zone.average, zone.p95, zone.p99, zone.calls);
+        textRenderer.draw(renderer, line, x + 10, y + 10 + lineHeight * (i + 1), rowColor);
+    }
+
+    // Object counts, each type followed by how many the view culling skipped
+    int countersY = y + 10 + lineHeight * (PROFILE_ZONE_COUNT + 1);
+    snprintf(line, sizeof(line), "%-12s %6s", "drawn", "avg");
+    textRenderer.draw(renderer, line, x + 10, countersY, headerColor);
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+        snprintf(line, sizeof(line), "%-12s %6.0f", COUNTER_NAMES[i], cachedCounters[i]);
+        textRenderer.draw(renderer, line, x + 10, countersY + lineHeight * (i + 1), rowColor);
+    }
+}
+
+void Profiler::printSummary(ostream& out) {
+    char line[80];
+    snprintf(line, sizeof(line), "%-12s %8s %8s %8s %5s", "zone (ms)", "avg", "p95", "p99", "calls");
+    out << line << endl;
+    for (int i = 0; i < PROFILE_ZONE_COUNT; ++i) {
+        ProfileZoneStats zone = zoneStats(static_cast<ProfileZone>(i));
+        string name = string(ZONE_DEPTH[i], ' ') + ZONE_NAMES[i];
+        snprintf(line, sizeof(line), "%-12s %8.3f %8.3f %8.3f %5d",
+                 name.c_str(), zone.average, zone.p95, zone.p99, zone.calls);
+        out << line << endl;
+    }
+
+    // Headless runs draw nothing, so leave the counters out when they are all zero
+    double counters[PROFILE_COUNTER_COUNT];
+    bool anyCounted = false;
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+        counters[i] = counterAverage(static_cast<ProfileCounter>(i));
+        anyCounted = anyCounted || counters[i] > 0.0;
+    }
+    if (!anyCounted) {
+        return;
+    }
+    snprintf(line, sizeof(line), "%-12s %8s", "drawn", "avg");
+    out << line << endl;
+    for (int i = 0; i < PROFILE_COUNTER_COUNT; ++i) {
+        snprintf(line, sizeof(line), "%-12s %8.1f", COUNTER_NAMES[i], counters[i]);
+        out << line << endl;
+    }
+}
+
+bool Profiler::writeChromeTrace(const string& path) {
+    ofstream file(path);
+    if (!file) {
+        cerr << "Unable to write profiler trace " << path << "!" << endl;
+        return false;
+    }
+
+    // Complete ("X") events with microsecond timestamps from the capture start
+    const double ticksPerUs = SDL_GetPerformanceFrequency() / 1e6;
+    char event[160];
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (size_t i = 0; i < traceEvents.size(); ++i) {
+        const TraceEvent& e = traceEvents[i];
+        snprintf(event, sizeof(event),
+                 "{\"name\":\"%s\",\"cat\":\"game\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%lu}%s\n",
+                 zoneName(e.zone), (e.start - captureStart) / ticksPerUs, (e.end - e.start) / ticksPerUs,
+                 static_cast<unsigned long>(e.thread),
+                 i + 1 < traceEvents.size() ? "," : "");
+        file << event;
+    }
+    file << "]}\n";
+    return static_cast<bool>(file);
+}
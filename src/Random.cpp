@@ -0,0 +1,82 @@
+#include "Random.h"
+
+namespace {
+    // splitmix64, used to spread a 64-bit seed over generator state
+    Uint64 splitMix64(Uint64& x) {
+        Uint64 z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    Uint32 rotl(Uint32 x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+}
+
+Rng::Rng(Uint64 seed_) {
+    seed(seed_);
+}
+
+void Rng::seed(Uint64 seed_) {
+    Uint64 a = splitMix64(seed_);
+    Uint64 b = splitMix64(seed_);
+    state[0] = static_cast<Uint32>(a);
+    state[1] = static_cast<Uint32>(a >> 32);
+    state[2] = static_cast<Uint32>(b);
+    state[3] = static_cast<Uint32>(b >> 32);
+}
+
+Uint32 Rng::next() {
+    Uint32 result = rotl(state[1] * 5, 7) * 9;
+    Uint32 t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 11);
+
+    return result;
+}
+
+float Rng::uniform(float min, float max) {
+    // Top 24 bits give every float in [0, 1) the same spacing
+    float unit = (next() >> 8) * (1.0f / 16777216.0f);
+    return min + (max - min) * unit;
+}
+
+int Rng::uniformInt(int min, int max) {
+    if (max <= min) {
+        return min;
+    }
+    // Multiply-shift range reduction; bias is negligible for game-sized ranges
+    Uint64 range = static_cast<Uint64>(static_cast<Sint64>(max) - min + 1);
+    return min + static_cast<int>((next() * range) >> 32);
+}
+
+RandomService::RandomService(Uint64 seed) {
+    reseed(seed);
+}
+
+void RandomService::reseed(Uint64 seed) {
+    masterSeed = seed;
+    beginRun(0);
+}
+
+void RandomService::beginRun(Uint32 runIndex) {
+    // Run 0 uses the master seed as is
+    Uint64 mix = masterSeed ^ (runIndex * 0xD1B54A32D192ED03ull);
+    for (auto& stream : streams) {
+        stream.seed(splitMix64(mix));
+    }
+}
+
+Uint64 RandomService::getSeed() const {
+    return masterSeed;
+}
+
+Rng& RandomService::stream(RngStream id) {
+    return streams[static_cast<int>(id)];
+}
@@ -0,0 +1,190 @@
+#include "Replay.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const char REPLAY_MAGIC[4] = {'T', 'R', 'P', 'L'};
+const Uint8 REPLAY_VERSION = 1;
+const Uint8 REPLAY_END = 0xFF; // Record type closing a run
+
+void writeVarint(vector<Uint8>& out, Uint32 value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<Uint8>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<Uint8>(value));
+}
+
+void writeFixed(vector<Uint8>& out, Uint64 value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<Uint8>(value >> (8 * i)));
+    }
+}
+
+// Bounds-checked cursor over the file contents
+struct ReplayStream {
+    const vector<Uint8>& data;
+    size_t pos;
+    bool ok;
+
+    bool readByte(Uint8& value) {
+        if (pos >= data.size()) {
+            ok = false;
+            return false;
+        }
+        value = data[pos++];
+        return true;
+    }
+
+    bool readVarint(Uint32& value) {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            Uint8 byte;
+            if (!readByte(byte)) {
+                return false;
+            }
+            value |= static_cast<Uint32>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        ok = false;
+        return false;
+    }
+
+    bool readFixed(Uint64& value, int bytes) {
+        value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            Uint8 byte;
+            if (!readByte(byte)) {
+                return false;
+            }
+            value |= static_cast<Uint64>(byte) << (8 * i);
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+Replay::Replay() : tickRate(0), masterSeed(0) {}
+
+void Replay::clear() {
+    runs.clear();
+}
+
+bool Replay::save(const string& path) const {
+    vector<Uint8> out(REPLAY_MAGIC, REPLAY_MAGIC + sizeof(REPLAY_MAGIC));
+    out.push_back(REPLAY_VERSION);
+    writeFixed(out, static_cast<Uint16>(tickRate), 2);
+    writeFixed(out, masterSeed, 8);
+
+    for (const ReplayRun& run : runs) {
+        writeVarint(out, run.runIndex);
+        Uint32 lastTick = 0;
+        for (const ReplayInput& input : run.inputs) {
+            writeVarint(out, input.tick - lastTick);
+            lastTick = input.tick;
+            out.push_back(static_cast<Uint8>(input.event.type));
+
+            if (input.event.type == InputType::AIM) {
+                // Raw float bits so playback gets exactly the recorded angle
+                Uint32 bits;
+                memcpy(&bits, &input.event.angle, sizeof(bits));
+                writeFixed(out, bits, 4);
+            } else if (input.event.type != InputType::PAUSE_TOGGLE) {
+                out.push_back(input.event.code);
+            }
+        }
+        writeVarint(out, run.ticks - lastTick);
+        out.push_back(REPLAY_END);
+        writeFixed(out, run.checksum, 4);
+    }
+
+    ofstream file(path, ios::binary);
+    if (!file) {
+        cerr << "Unable to write replay " << path << "!" << endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), out.size());
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const string& path) {
+    ifstream file(path, ios::binary);
+    if (!file) {
+        cerr << "Unable to open replay " << path << "!" << endl;
+        return false;
+    }
+    vector<Uint8> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+    runs.clear();
+    ReplayStream in = {data, sizeof(REPLAY_MAGIC), true};
+    Uint8 version = 0;
+    Uint64 rate = 0;
+    if (data.size() < sizeof(REPLAY_MAGIC) || memcmp(data.data(), REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0 ||
+        !in.readByte(version) || version != REPLAY_VERSION ||
+        !in.readFixed(rate, 2) || !in.readFixed(masterSeed, 8)) {
+        cerr << "Invalid replay " << path << endl;
+        return false;
+    }
+    tickRate = static_cast<int>(rate);
+
+    while (in.ok && in.pos < data.size()) {
+        ReplayRun run = {0, 0, 0, {}};
+        if (!in.readVarint(run.runIndex)) {
+            break;
+        }
+
+        Uint32 tick = 0;
+        while (true) {
+            Uint32 delta;
+            Uint8 type;
+            if (!in.readVarint(delta) || !in.readByte(type)) {
+                break;
+            }
+            tick += delta;
+
+            if (type == REPLAY_END) {
+                Uint64 checksum;
+                if (in.readFixed(checksum, 4)) {
+                    run.ticks = tick;
+                    run.checksum = static_cast<Uint32>(checksum);
+                }
+                break;
+            }
+            if (type > static_cast<Uint8>(InputType::PAUSE_TOGGLE)) {
+                in.ok = false;
+                break;
+            }
+
+            ReplayInput input = {tick, {static_cast<InputType>(type), 0, 0.0f}};
+            if (input.event.type == InputType::AIM) {
+                Uint64 bits;
+                if (!in.readFixed(bits, 4)) {
+                    break;
+                }
+                Uint32 bits32 = static_cast<Uint32>(bits);
+                memcpy(&input.event.angle, &bits32, sizeof(bits32));
+            } else if (input.event.type != InputType::PAUSE_TOGGLE && !in.readByte(input.event.code)) {
+                break;
+            }
+            run.inputs.push_back(input);
+        }
+
+        if (!in.ok) {
+            break;
+        }
+        runs.push_back(run);
+    }
+
+    if (!in.ok) {
+        cerr << "Truncated or corrupt replay " << path << endl;
+        return false;
+    }
+    return true;
+}
@@ -1,55 +1,468 @@
 #include "ResourceManager.h"
 
-unordered_map<string, SDL_Texture*> ResourceManager::textures;
-unordered_map<string, Mix_Chunk*> ResourceManager::sounds;
-unordered_map<string, Mix_Music*> ResourceManager::music;
+#include <cmath>
+
+#include "Constants.h"
+#include "PixelOps.h"
+
+#define ASSET_PATH_ENTRY(id, path, ...) path,
+#define ASSET_GROUP_ENTRY(id, path, group) LoadGroup::group,
+#define TEXTURE_GROUP_ENTRY(id, path, group, packing) LoadGroup::group,
+#define TEXTURE_PACKING_ENTRY(id, path, group, packing) TexturePacking::packing,
+
+TextureRegion ResourceManager::regions[TEXTURE_COUNT] = {};
+SDL_Texture* ResourceManager::textures[TEXTURE_COUNT] = {};
+Mix_Chunk* ResourceManager::sounds[SOUND_COUNT] = {};
+Mix_Music* ResourceManager::music[MUSIC_COUNT] = {};
+const char* const ResourceManager::texturePaths[TEXTURE_COUNT] = {TEXTURE_ASSETS(ASSET_PATH_ENTRY)};
+const char* const ResourceManager::soundPaths[SOUND_COUNT] = {SOUND_ASSETS(ASSET_PATH_ENTRY)};
+const char* const ResourceManager::musicPaths[MUSIC_COUNT] = {MUSIC_ASSETS(ASSET_PATH_ENTRY)};
+const LoadGroup ResourceManager::textureGroups[TEXTURE_COUNT] = {TEXTURE_ASSETS(TEXTURE_GROUP_ENTRY)};
+const LoadGroup ResourceManager::soundGroups[SOUND_COUNT] = {SOUND_ASSETS(ASSET_GROUP_ENTRY)};
+const TexturePacking ResourceManager::texturePacking[TEXTURE_COUNT] = {TEXTURE_ASSETS(TEXTURE_PACKING_ENTRY)};
+TextureAtlas ResourceManager::atlases[static_cast<int>(LoadGroup::COUNT)];
+
+#undef ASSET_PATH_ENTRY
+#undef ASSET_GROUP_ENTRY
+#undef TEXTURE_GROUP_ENTRY
+#undef TEXTURE_PACKING_ENTRY
+
+SDL_Surface* ResourceManager::sourceSurfaces[TEXTURE_COUNT] = {};
+SDL_Texture* ResourceManager::proceduralTextures[static_cast<int>(ProceduralSprite::COUNT)][PROCEDURAL_RADIUS_BUCKETS] = {};
+
+vector<ResourceManager::LoadJob> ResourceManager::loadJobs;
+vector<SDL_Thread*> ResourceManager::loadWorkers;
+SDL_atomic_t ResourceManager::nextLoadJob = {0};
+SDL_mutex* ResourceManager::decodedMutex = nullptr;
+SDL_mutex* ResourceManager::sourceMutex = nullptr;
+vector<int> ResourceManager::decodedJobs;
+vector<int> ResourceManager::pendingUploads;
+int ResourceManager::jobsFinished = 0;
+AssetPack ResourceManager::pack;
+int ResourceManager::groupRemaining[static_cast<int>(LoadGroup::COUNT)] = {};
 
 void ResourceManager::init(SDL_Renderer* renderer) {
-    loadTexture("assets/images/tank/player/tank_shoot_spritesheet.png", renderer);
-    loadTexture("assets/images/tank/npc/enemy_tank.png", renderer);
-    loadTexture("assets/images/effect/explosion.png", renderer);
-    loadTexture("assets/images/item/powerup.png", renderer);
-    loadTexture("assets/images/item/health_pickup.png", renderer);
-    loadTexture("assets/images/tank/player/tank_shield_spritesheet.png", renderer);
+    // Atlas pages must stay within what the renderer can hold in one texture
+    int pageSize = ATLAS_PAGE_SIZE;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0 && info.max_texture_height > 0) {
+        pageSize = min(pageSize, min(info.max_texture_width, info.max_texture_height));
+    }
+    for (auto& atlas : atlases) {
+        atlas.setMaxPageSize(pageSize);
+    }
+
+    // Menu assets first so the menu can be shown while the rest streams in
+    for (int group = 0; group < static_cast<int>(LoadGroup::COUNT); ++group) {
+        LoadGroup loadGroup = static_cast<LoadGroup>(group);
+
+        for (int id = 0; id < TEXTURE_COUNT; ++id) {
+            if (textureGroups[id] != loadGroup) {
+                continue;
+            }
+            if (static_cast<TextureId>(id) == TextureId::PLAYER_SHIELD) {
+                queueRecoloredTexture(TextureId::PLAYER_TANK, TextureId::PLAYER_SHIELD,
+                                      100, 255, 100, // Green tint
+                                      loadGroup);
+            } else {
+                queueTexture(static_cast<TextureId>(id), loadGroup);
+            }
+        }
+
+        for (int id = 0; id < SOUND_COUNT; ++id) {
+            if (soundGroups[id] == loadGroup) {
+                queueSound(static_cast<SoundId>(id), loadGroup);
+            }
+        }
+    }
+
+    // Music is streamed, so opening it is cheap. Doing it here also lets
+    // SDL_mixer finish its lazy decoder setup before any worker decodes.
+    for (int id = 0; id < MUSIC_COUNT; ++id) {
+        loadMusic(static_cast<MusicId>(id));
+    }
+
+    startLoading();
+}
+
+bool ResourceManager::openPack(const string& path) {
+    if (!pack.open(path)) {
+        return false;
+    }
+    cout << "Using asset pack " << path << endl;
+    return true;
+}
+
+SDL_RWops* ResourceManager::openAsset(const string& path) {
+    const AssetPackEntry* entry = pack.find(path);
+    if (entry && entry->type == PACK_RAW_FILE) {
+        return SDL_RWFromConstMem(pack.data(*entry), static_cast<int>(entry->size));
+    }
+    return SDL_RWFromFile(path.c_str(), "rb");
+}
+
+SDL_Surface* ResourceManager::loadSurface(const string& path) {
+    // Packed images are already RGBA32: wrap the mapped pixels, no decode or copy.
+    // An entry too short for its size is ignored rather than read past.
+    const AssetPackEntry* entry = pack.find(path);
+    if (entry && entry->type == PACK_TEXTURE_RGBA32 &&
+        entry->size >= static_cast<Uint64>(entry->param0) * entry->param1 * 4) {
+        void* pixels = const_cast<void*>(pack.data(*entry));
+        int width = static_cast<int>(entry->param0);
+        int height = static_cast<int>(entry->param1);
+        return SDL_CreateRGBSurfaceWithFormatFrom(pixels, width, height, 32, width * 4, SDL_PIXELFORMAT_RGBA32);
+    }
+    return IMG_Load(path.c_str());
+}
+
+Mix_Chunk* ResourceManager::loadChunk(const string& path) {
+    // Packed PCM can be played straight from the mapping if the mixer format matches
+    const AssetPackEntry* entry = pack.find(path);
+    if (entry && entry->type == PACK_AUDIO_PCM) {
+        int frequency = 0;
+        Uint16 format = 0;
+        int channels = 0;
+        Mix_QuerySpec(&frequency, &format, &channels);
+        // A truncated entry would end mid-frame, so it is decoded from the file instead
+        Uint32 frameSize = SDL_AUDIO_BITSIZE(format) / 8 * channels;
+        if (entry->param0 == static_cast<Uint32>(frequency) && entry->param1 == format &&
+            entry->param2 == static_cast<Uint32>(channels) && frameSize > 0 && entry->size % frameSize == 0) {
+            Uint8* samples = static_cast<Uint8*>(const_cast<void*>(pack.data(*entry)));
+            return Mix_QuickLoad_RAW(samples, entry->size);
+        }
+    }
+    return Mix_LoadWAV_RW(openAsset(path), 1);
+}
+
+void ResourceManager::queueTexture(TextureId id, LoadGroup group) {
+    const char* path = getPath(id);
+    loadJobs.push_back({LoadKind::TEXTURE, group, static_cast<int>(id), path, -1, 255, 255, 255, nullptr, nullptr, ""});
+    groupRemaining[static_cast<int>(group)]++;
+}
+
+void ResourceManager::queueRecoloredTexture(TextureId source, TextureId id, Uint8 r, Uint8 g, Uint8 b,
+                                            LoadGroup group) {
+    loadJobs.push_back({LoadKind::RECOLORED_TEXTURE, group, static_cast<int>(id), getPath(id), static_cast<int>(source),
+                        r, g, b, nullptr, nullptr, ""});
+    groupRemaining[static_cast<int>(group)]++;
+}
+
+void ResourceManager::queueSound(SoundId id, LoadGroup group) {
+    const char* path = getPath(id);
+    loadJobs.push_back({LoadKind::SOUND, group, static_cast<int>(id), path, -1, 255, 255, 255, nullptr, nullptr, ""});
+    groupRemaining[static_cast<int>(group)]++;
+}
+
+void ResourceManager::startLoading() {
+    if (!loadWorkers.empty() || loadJobs.empty()) {
+        return;
+    }
+
+    decodedMutex = SDL_CreateMutex();
+    sourceMutex = SDL_CreateMutex();
+    SDL_AtomicSet(&nextLoadJob, 0);
+
+    // Leave one core for the main thread, which keeps rendering meanwhile
+    int workerCount = max(1, min(SDL_GetCPUCount() - 1, 4));
+    for (int i = 0; i < workerCount; ++i) {
+        SDL_Thread* worker = SDL_CreateThread(loadWorker, "AssetLoader", nullptr);
+        if (worker) {
+            loadWorkers.push_back(worker);
+        }
+    }
+
+    if (loadWorkers.empty()) {
+        cerr << "Unable to start asset loader threads! SDL_Error: " << SDL_GetError() << endl;
+    }
+}
+
+int ResourceManager::loadWorker(void*) {
+    // Jobs are claimed in queue order, so earlier groups finish first
+    while (true) {
+        int index = SDL_AtomicAdd(&nextLoadJob, 1);
+        if (index >= static_cast<int>(loadJobs.size())) {
+            return 0;
+        }
 
-    loadSound("assets/sounds/shoot.mp3");
-    loadSound("assets/sounds/rapid_fire.mp3");
-    loadSound("assets/sounds/explosion.mp3");
-    loadSound("assets/sounds/powerup.mp3");
-    loadSound("assets/sounds/shield_activate.mp3"); 
-    loadSound("assets/sounds/shield_deactivate.mp3"); 
-    loadSound("assets/sounds/heal.mp3"); 
+        decodeJob(loadJobs[index]);
 
+        SDL_LockMutex(decodedMutex);
+        decodedJobs.push_back(index);
+        SDL_UnlockMutex(decodedMutex);
+    }
+}
+
+void ResourceManager::decodeJob(LoadJob& job) {
+    switch (job.kind) {
+        case LoadKind::TEXTURE:
+            job.surface = loadSurface(job.path);
+            if (!job.surface) {
+                job.error = string("Unable to load image ") + job.path + "! SDL_image Error: " + IMG_GetError();
+            }
+            break;
+
+        case LoadKind::RECOLORED_TEXTURE: {
+            // A prebaked image under the new name wins
+            job.surface = loadSurface(job.path);
+            if (job.surface) {
+                break;
+            }
+
+            // Converting a surface updates its blit map, so jobs sharing a
+            // source recolour it one at a time
+            TextureId sourceId = static_cast<TextureId>(job.sourceId);
+            SDL_LockMutex(sourceMutex);
+            SDL_Surface* source = getSourceSurface(sourceId);
+            if (source) {
+                job.surface = recolorSurface(source, job.r, job.g, job.b);
+            }
+            SDL_UnlockMutex(sourceMutex);
+
+            if (!source) {
+                job.error = string("Unable to load image ") + getPath(sourceId) + "! SDL_image Error: " + IMG_GetError();
+            } else if (!job.surface) {
+                job.error = string("Unable to recolor ") + getPath(sourceId) + "! SDL Error: " + SDL_GetError();
+            }
+            break;
+        }
 
-    loadMusic("assets/sounds/background_music.mp3");
+        case LoadKind::SOUND:
+            job.chunk = loadChunk(job.path);
+            if (!job.chunk) {
+                job.error = string("Unable to load sound ") + job.path + "! SDL_mixer Error: " + Mix_GetError();
+            }
+            break;
+    }
+}
+
+void ResourceManager::finishJob(LoadJob& job, SDL_Renderer* renderer) {
+    if (!job.error.empty()) {
+        cerr << job.error << endl;
+    }
+
+    if (job.surface) {
+        TextureAtlas& atlas = atlases[static_cast<int>(job.group)];
+        if (texturePacking[job.id] == TexturePacking::ATLAS && atlas.add(job.id, job.surface)) {
+            // Uploaded with the rest of the group in buildAtlas
+            job.surface = nullptr;
+        } else {
+            SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, job.surface);
+            SDL_FreeSurface(job.surface);
+            job.surface = nullptr;
+
+            if (!texture) {
+                cerr << "Unable to create texture from " << job.path << "! SDL_Error: " << SDL_GetError() << endl;
+            } else {
+                setTexture(static_cast<TextureId>(job.id), texture);
+            }
+        }
+    }
+
+    if (job.chunk) {
+        sounds[job.id] = job.chunk;
+        job.chunk = nullptr;
+    }
+
+    // Publish the group's atlas before the group reports as loaded
+    if (groupRemaining[static_cast<int>(job.group)] == 1) {
+        buildAtlas(job.group, renderer);
+    }
+    groupRemaining[static_cast<int>(job.group)]--;
+    jobsFinished++;
+}
+
+void ResourceManager::buildAtlas(LoadGroup group, SDL_Renderer* renderer) {
+    TextureAtlas& atlas = atlases[static_cast<int>(group)];
+    if (!atlas.hasPending()) {
+        return;
+    }
+
+    for (const auto& placement : atlas.build(renderer)) {
+        regions[placement.id] = placement.region;
+    }
+}
+
+void ResourceManager::setTexture(TextureId id, SDL_Texture* texture) {
+    int w = 0;
+    int h = 0;
+    SDL_QueryTexture(texture, nullptr, nullptr, &w, &h);
+    textures[static_cast<int>(id)] = texture;
+    regions[static_cast<int>(id)] = {texture, {0, 0, w, h}};
+}
+
+bool ResourceManager::pumpLoading(SDL_Renderer* renderer, Uint32 budgetMs) {
+    if (jobsFinished >= static_cast<int>(loadJobs.size())) {
+        return true;
+    }
+
+    // No workers could be started: decode here, one job per call
+    if (loadWorkers.empty()) {
+        int index = SDL_AtomicAdd(&nextLoadJob, 1);
+        if (index < static_cast<int>(loadJobs.size())) {
+            decodeJob(loadJobs[index]);
+            pendingUploads.push_back(index);
+        }
+    } else {
+        SDL_LockMutex(decodedMutex);
+        pendingUploads.insert(pendingUploads.end(), decodedJobs.begin(), decodedJobs.end());
+        decodedJobs.clear();
+        SDL_UnlockMutex(decodedMutex);
+    }
+
+    // Spread texture uploads over frames so the loading screen stays responsive
+    Uint64 start = SDL_GetPerformanceCounter();
+    Uint64 budget = SDL_GetPerformanceFrequency() * budgetMs / 1000;
+    size_t uploaded = 0;
+    while (uploaded < pendingUploads.size()) {
+        finishJob(loadJobs[pendingUploads[uploaded]], renderer);
+        uploaded++;
+        if (SDL_GetPerformanceCounter() - start >= budget) {
+            break;
+        }
+    }
+    pendingUploads.erase(pendingUploads.begin(), pendingUploads.begin() + uploaded);
+
+    if (jobsFinished < static_cast<int>(loadJobs.size())) {
+        return false;
+    }
+
+    stopLoading();
+    return true;
+}
+
+void ResourceManager::stopLoading() {
+    // Make the workers run out of jobs, then wait for them
+    SDL_AtomicSet(&nextLoadJob, static_cast<int>(loadJobs.size()));
+    for (SDL_Thread* worker : loadWorkers) {
+        SDL_WaitThread(worker, nullptr);
+    }
+    loadWorkers.clear();
+
+    // Anything decoded but never uploaded (quitting mid-load) is released here
+    for (auto& job : loadJobs) {
+        if (job.surface) {
+            SDL_FreeSurface(job.surface);
+        }
+        if (job.chunk) {
+            Mix_FreeChunk(job.chunk);
+        }
+    }
+    loadJobs.clear();
+    decodedJobs.clear();
+    pendingUploads.clear();
+    jobsFinished = 0;
+    for (int& remaining : groupRemaining) {
+        remaining = 0;
+    }
+
+    if (decodedMutex) {
+        SDL_DestroyMutex(decodedMutex);
+        decodedMutex = nullptr;
+    }
+    if (sourceMutex) {
+        SDL_DestroyMutex(sourceMutex);
+        sourceMutex = nullptr;
+    }
+}
+
+bool ResourceManager::isGroupLoaded(LoadGroup group) {
+    return groupRemaining[static_cast<int>(group)] == 0;
+}
+
+float ResourceManager::loadingProgress() {
+    if (loadJobs.empty()) {
+        return 1.0f;
+    }
+    return static_cast<float>(jobsFinished) / loadJobs.size();
+}
+
+TextureHandle ResourceManager::textureHandle(TextureId id) {
+    return TextureHandle(&regions[static_cast<int>(id)]);
+}
+
+SoundHandle ResourceManager::soundHandle(SoundId id) {
+    return SoundHandle(&sounds[static_cast<int>(id)]);
+}
+
+MusicHandle ResourceManager::musicHandle(MusicId id) {
+    return MusicHandle(&music[static_cast<int>(id)]);
+}
+
+const char* ResourceManager::getPath(TextureId id) {
+    return texturePaths[static_cast<int>(id)];
+}
+
+const char* ResourceManager::getPath(SoundId id) {
+    return soundPaths[static_cast<int>(id)];
+}
+
+const char* ResourceManager::getPath(MusicId id) {
+    return musicPaths[static_cast<int>(id)];
 }
 
 void ResourceManager::cleanup() {
-    for (auto& pair : textures) {
-        SDL_DestroyTexture(pair.second);
+    stopLoading();
+
+    for (auto& texture : textures) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+            texture = nullptr;
+        }
+    }
+
+    for (auto& atlas : atlases) {
+        atlas.destroy();
+    }
+
+    for (auto& region : regions) {
+        region = {nullptr, {0, 0, 0, 0}};
+    }
+
+    // Packed sources point into the mapping too
+    for (auto& surface : sourceSurfaces) {
+        if (surface) {
+            SDL_FreeSurface(surface);
+            surface = nullptr;
+        }
+    }
+
+    for (auto& bucket : proceduralTextures) {
+        for (auto& texture : bucket) {
+            if (texture) {
+                SDL_DestroyTexture(texture);
+                texture = nullptr;
+            }
+        }
     }
-    textures.clear();
 
-    for (auto& pair : sounds) {
-        Mix_FreeChunk(pair.second);
+    for (auto& sound : sounds) {
+        if (sound) {
+            Mix_FreeChunk(sound);
+            sound = nullptr;
+        }
     }
-    sounds.clear();
 
-    for (auto& pair : music) {
-        Mix_FreeMusic(pair.second);
+    for (auto& mus : music) {
+        if (mus) {
+            Mix_FreeMusic(mus);
+            mus = nullptr;
+        }
     }
-    music.clear();
+
+    // Packed chunks and music point into the mapping, so unmap last
+    pack.close();
 }
 
-SDL_Texture* ResourceManager::loadTexture(const string& path, SDL_Renderer* renderer) {
+TextureHandle ResourceManager::loadTexture(TextureId id, SDL_Renderer* renderer) {
     // Check if texture is already loaded
-    auto it = textures.find(path);
-    if (it != textures.end()) {
-        return it->second;
+    TextureHandle handle = textureHandle(id);
+    if (handle.ready()) {
+        return handle;
     }
+    const char* path = getPath(id);
 
     // Load new texture
-    SDL_Surface* surface = IMG_Load(path.c_str());
+    SDL_Surface* surface = loadSurface(path);
     if (!surface) {
         cerr << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << endl;
         return nullptr;
@@ -63,141 +476,150 @@ SDL_Texture* ResourceManager::loadTexture(const string& path, SDL_Renderer* rend
         return nullptr;
     }
 
-    textures[path] = texture;
-    return texture;
+    setTexture(id, texture);
+    return handle;
 }
 
 
-SDL_Texture* ResourceManager::createRecoloredTexture(const string& sourcePath, const string& newPath, SDL_Renderer* renderer, Uint8 r, Uint8 g, Uint8 b) {
-
-    auto it = textures.find(newPath);
-    if (it != textures.end()) {
-        return it->second;
-    }
-
-
-    SDL_Surface* sourceSurface = IMG_Load(sourcePath.c_str());
-    if (!sourceSurface) {
-        cerr << "Unable to load image " << sourcePath << "! SDL_image Error: " << IMG_GetError() << endl;
-        return nullptr;
+SDL_Surface* ResourceManager::getSourceSurface(TextureId id) {
+    SDL_Surface*& surface = sourceSurfaces[static_cast<int>(id)];
+    if (!surface) {
+        surface = loadSurface(getPath(id));
     }
+    return surface;
+}
 
-
-    SDL_Surface* newSurface = SDL_CreateRGBSurfaceWithFormat(0, sourceSurface->w, sourceSurface->h,
-                                                             32, sourceSurface->format->format);
+// Multiplies every visible pixel by (r, g, b) / 255 into a new RGBA32
+// surface. Touches no renderer state, so the asset loader workers can call it too.
+SDL_Surface* ResourceManager::recolorSurface(SDL_Surface* source, Uint8 r, Uint8 g, Uint8 b) {
+    // Converting also copies, and gives the kernel a byte order it can rely on
+    SDL_Surface* newSurface = SDL_ConvertSurfaceFormat(source, SDL_PIXELFORMAT_RGBA32, 0);
     if (!newSurface) {
-        cerr << "Unable to create surface! SDL Error: " << SDL_GetError() << endl;
-        SDL_FreeSurface(sourceSurface);
         return nullptr;
     }
 
-
-    SDL_BlitSurface(sourceSurface, NULL, newSurface, NULL);
-
-
     if (SDL_LockSurface(newSurface) < 0) {
-        cerr << "Unable to lock surface! SDL Error: " << SDL_GetError() << endl;
-        SDL_FreeSurface(sourceSurface);
         SDL_FreeSurface(newSurface);
         return nullptr;
     }
 
+    Uint8* row = static_cast<Uint8*>(newSurface->pixels);
+    if (newSurface->pitch == newSurface->w * 4) {
+        tintPixelsRGBA32(reinterpret_cast<Uint32*>(row), newSurface->w * newSurface->h, r, g, b);
+    } else {
+        for (int y = 0; y < newSurface->h; ++y, row += newSurface->pitch) {
+            tintPixelsRGBA32(reinterpret_cast<Uint32*>(row), newSurface->w, r, g, b);
+        }
+    }
 
-    Uint32* pixels = static_cast<Uint32*>(newSurface->pixels);
-    int pixelCount = newSurface->w * newSurface->h;
-
-    SDL_PixelFormat* format = newSurface->format;
+    SDL_UnlockSurface(newSurface);
+    return newSurface;
+}
 
-    for (int i = 0; i < pixelCount; ++i) {
-        Uint8 sr, sg, sb, sa;
-        SDL_GetRGBA(pixels[i], format, &sr, &sg, &sb, &sa);
+SDL_Texture* ResourceManager::getProceduralTexture(SDL_Renderer* renderer, ProceduralSprite sprite, int radius) {
+    // Smallest bucket that fits; larger radii stretch the biggest one
+    int bucket = 0;
+    while (bucket < PROCEDURAL_RADIUS_BUCKETS - 1 && (8 << bucket) < radius) {
+        ++bucket;
+    }
 
+    SDL_Texture*& texture = proceduralTextures[static_cast<int>(sprite)][bucket];
+    if (!texture) {
+        texture = createProceduralTexture(renderer, sprite, 8 << bucket);
+    }
+    return texture;
+}
 
-        if (sa > 0) {
+SDL_Texture* ResourceManager::createProceduralTexture(SDL_Renderer* renderer, ProceduralSprite sprite, int radius) {
+    int size = radius * 2;
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        cerr << "Unable to create surface! SDL Error: " << SDL_GetError() << endl;
+        return nullptr;
+    }
 
-            Uint8 nr = min(255, static_cast<int>(sr * r / 255));
-            Uint8 ng = min(255, static_cast<int>(sg * g / 255));
-            Uint8 nb = min(255, static_cast<int>(sb * b / 255));
+    if (SDL_LockSurface(surface) < 0) {
+        cerr << "Unable to lock surface! SDL Error: " << SDL_GetError() << endl;
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
 
-            pixels[i] = SDL_MapRGBA(format, nr, ng, nb, sa);
+    for (int h = 0; h < size; ++h) {
+        Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + h * surface->pitch);
+        for (int w = 0; w < size; ++w) {
+            int dx = w - radius;
+            int dy = h - radius;
+            int distanceSquared = dx * dx + dy * dy;
+
+            Uint8 alpha = 0;
+            if (distanceSquared <= radius * radius) {
+                if (sprite == ProceduralSprite::RADIAL_GRADIENT) {
+                    float falloff = 1.0f - sqrt(static_cast<float>(distanceSquared)) / radius;
+                    alpha = static_cast<Uint8>(255 * falloff);
+                } else {
+                    alpha = 255;
+                }
+            }
+            row[w] = SDL_MapRGBA(surface->format, 255, 255, 255, alpha);
         }
     }
 
-    SDL_UnlockSurface(newSurface);
-
-
-    SDL_Texture* newTexture = SDL_CreateTextureFromSurface(renderer, newSurface);
-
+    SDL_UnlockSurface(surface);
 
-    SDL_FreeSurface(sourceSurface);
-    SDL_FreeSurface(newSurface);
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
 
-    if (!newTexture) {
+    if (!texture) {
         cerr << "Unable to create texture! SDL Error: " << SDL_GetError() << endl;
         return nullptr;
     }
 
-
-    textures[newPath] = newTexture;
-    return newTexture;
-}
-
-SDL_Texture* ResourceManager::getTexture(const string& path) {
-    auto it = textures.find(path);
-    if (it != textures.end()) {
-        return it->second;
-    }
-    return nullptr;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
 }
 
-Mix_Chunk* ResourceManager::loadSound(const string& path) {
+Mix_Chunk* ResourceManager::loadSound(SoundId id) {
     // Check if sound is already loaded
-    auto it = sounds.find(path);
-    if (it != sounds.end()) {
-        return it->second;
+    Mix_Chunk*& slot = sounds[static_cast<int>(id)];
+    if (slot) {
+        return slot;
     }
+    const char* path = getPath(id);
 
     // Load new sound
-    Mix_Chunk* sound = Mix_LoadWAV(path.c_str());
+    Mix_Chunk* sound = loadChunk(path);
     if (!sound) {
         cerr << "Unable to load sound " << path << "! SDL_mixer Error: " << Mix_GetError() << endl;
         return nullptr;
     }
 
-    sounds[path] = sound;
+    slot = sound;
     return sound;
 }
 
-Mix_Chunk* ResourceManager::getSound(const string& path) {
-    auto it = sounds.find(path);
-    if (it != sounds.end()) {
-        return it->second;
-    }
-    return nullptr;
+Mix_Chunk* ResourceManager::getSound(SoundId id) {
+    return sounds[static_cast<int>(id)];
 }
 
-Mix_Music* ResourceManager::loadMusic(const string& path) {
+Mix_Music* ResourceManager::loadMusic(MusicId id) {
     // Check if music is already loaded
-    auto it = music.find(path);
-    if (it != music.end()) {
-        return it->second;
+    Mix_Music*& slot = music[static_cast<int>(id)];
+    if (slot) {
+        return slot;
     }
+    const char* path = getPath(id);
 
     // Load new music
-    Mix_Music* mus = Mix_LoadMUS(path.c_str());
+    Mix_Music* mus = Mix_LoadMUS_RW(openAsset(path), 1);
     if (!mus) {
         cerr << "Unable to load music " << path << "! SDL_mixer Error: " << Mix_GetError() << endl;
         return nullptr;
     }
 
-    music[path] = mus;
+    slot = mus;
     return mus;
 }
 
-Mix_Music* ResourceManager::getMusic(const string& path) {
-    auto it = music.find(path);
-    if (it != music.end()) {
-        return it->second;
-    }
-    return nullptr;
+Mix_Music* ResourceManager::getMusic(MusicId id) {
+    return music[static_cast<int>(id)];
 }
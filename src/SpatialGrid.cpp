@@ -0,0 +1,88 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+SpatialGrid::SpatialGrid(float worldWidth, float worldHeight, float cellSize_)
+    : cellSize(cellSize_), maxRadius(0) {
+    columns = max(1, static_cast<int>(ceil(worldWidth / cellSize)));
+    rows = max(1, static_cast<int>(ceil(worldHeight / cellSize)));
+    cellStart.assign(columns * rows + 1, 0);
+}
+
+int SpatialGrid::cellX(float x) const {
+    return max(0, min(columns - 1, static_cast<int>(floor(x / cellSize))));
+}
+
+int SpatialGrid::cellY(float y) const {
+    return max(0, min(rows - 1, static_cast<int>(floor(y / cellSize))));
+}
+
+void SpatialGrid::clear() {
+    pendingCell.clear();
+    pendingItem.clear();
+    cellItems.clear();
+    fill(cellStart.begin(), cellStart.end(), 0);
+    maxRadius = 0;
+}
+
+void SpatialGrid::insert(int index, float x, float y, float radius) {
+    pendingCell.push_back(cellY(y) * columns + cellX(x));
+    pendingItem.push_back(index);
+    maxRadius = max(maxRadius, radius);
+}
+
+void SpatialGrid::build() {
+    // Counting sort by cell: count, prefix sum, then scatter
+    fill(cellStart.begin(), cellStart.end(), 0);
+    for (int cell : pendingCell) {
+        cellStart[cell + 1]++;
+    }
+    for (size_t i = 1; i < cellStart.size(); ++i) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    cellItems.resize(pendingItem.size());
+    vector<int>& cursor = pendingCell; // Reused as write cursors once the counts are known
+    for (size_t i = 0; i < pendingItem.size(); ++i) {
+        int cell = cursor[i];
+        cursor[i] = cellStart[cell]++;
+    }
+    for (size_t i = 0; i < pendingItem.size(); ++i) {
+        cellItems[cursor[i]] = pendingItem[i];
+    }
+
+    // The scatter advanced every start to the next cell's start; shift back
+    for (size_t i = cellStart.size() - 1; i > 0; --i) {
+        cellStart[i] = cellStart[i - 1];
+    }
+    cellStart[0] = 0;
+
+    pendingCell.clear();
+    pendingItem.clear();
+}
+
+void SpatialGrid::query(float x, float y, float radius, vector<int>& out, int after) const {
+    out.clear();
+    float reach = radius + maxRadius;
+    int minX = cellX(x - reach);
+    int maxX = cellX(x + reach);
+    int minY = cellY(y - reach);
+    int maxY = cellY(y + reach);
+
+    for (int cy = minY; cy <= maxY; ++cy) {
+        for (int cx = minX; cx <= maxX; ++cx) {
+            int cell = cy * columns + cx;
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                if (cellItems[i] > after) {
+                    out.push_back(cellItems[i]);
+                }
+            }
+        }
+    }
+
+    // Callers resolve hits in index order, the same order as a linear scan
+    sort(out.begin(), out.end());
+}
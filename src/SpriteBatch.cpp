@@ -0,0 +1,135 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SpriteBatch::SpriteBatch(size_t reserveQuads) : groupCount(0), lastGroup(0), drawCalls(0) {
+    indices.reserve(reserveQuads * 6);
+}
+
+SpriteBatch::Group& SpriteBatch::groupFor(SDL_Texture* texture) {
+    if (lastGroup < groupCount && groups[lastGroup].texture == texture) {
+        return groups[lastGroup];
+    }
+
+    // A frame only touches a few textures, so a linear search beats a map
+    for (size_t i = 0; i < groupCount; ++i) {
+        if (groups[i].texture == texture) {
+            lastGroup = i;
+            return groups[i];
+        }
+    }
+
+    if (groupCount == groups.size()) {
+        groups.push_back(Group());
+    }
+    Group& group = groups[groupCount];
+    group.texture = texture;
+    group.invWidth = group.invHeight = 1.0f;
+    group.quadCount = 0;
+
+    int width = 0, height = 0;
+    if (texture && SDL_QueryTexture(texture, nullptr, nullptr, &width, &height) == 0 && width > 0 && height > 0) {
+        group.invWidth = 1.0f / width;
+        group.invHeight = 1.0f / height;
+    }
+
+    lastGroup = groupCount++;
+    return group;
+}
+
+void SpriteBatch::add(SDL_Texture* texture, const SDL_Rect* src, const SDL_FRect& dest, float angle, SDL_Color tint) {
+    Group& group = groupFor(texture);
+    size_t base = group.quadCount * 4;
+    if (group.vertices.size() < base + 4) {
+        group.vertices.resize(base + 4);
+    }
+
+    // Texture coordinates of the source rectangle, or the whole texture
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+    if (texture && src) {
+        u0 = src->x * group.invWidth;
+        v0 = src->y * group.invHeight;
+        u1 = (src->x + src->w) * group.invWidth;
+        v1 = (src->y + src->h) * group.invHeight;
+    }
+
+    // Corners relative to the centre, rotated the way SDL_RenderCopyEx does (y points down)
+    float halfW = dest.w / 2.0f;
+    float halfH = dest.h / 2.0f;
+    float centerX = dest.x + halfW;
+    float centerY = dest.y + halfH;
+    float c = 1.0f, s = 0.0f;
+    if (angle != 0.0f) {
+        c = cos(angle);
+        s = sin(angle);
+    }
+    const float cornerX[4] = {-halfW, halfW, halfW, -halfW};
+    const float cornerY[4] = {-halfH, -halfH, halfH, halfH};
+    const float cornerU[4] = {u0, u1, u1, u0};
+    const float cornerV[4] = {v0, v0, v1, v1};
+
+    SDL_Vertex* v = &group.vertices[base];
+    for (int i = 0; i < 4; ++i) {
+        v[i].position = {centerX + cornerX[i] * c - cornerY[i] * s, centerY + cornerX[i] * s + cornerY[i] * c};
+        v[i].color = tint;
+        v[i].tex_coord = {cornerU[i], cornerV[i]};
+    }
+
+    ++group.quadCount;
+}
+
+size_t SpriteBatch::size() const {
+    size_t quads = 0;
+    for (size_t i = 0; i < groupCount; ++i) {
+        quads += groups[i].quadCount;
+    }
+    return quads;
+}
+
+int SpriteBatch::lastDrawCalls() const {
+    return drawCalls;
+}
+
+void SpriteBatch::clear() {
+    groupCount = 0;
+    lastGroup = 0;
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    drawCalls = 0;
+
+    // Extend the shared index pattern to cover the largest group
+    size_t maxQuads = 0;
+    for (size_t i = 0; i < groupCount; ++i) {
+        maxQuads = max(maxQuads, groups[i].quadCount);
+    }
+    while (indices.size() < maxQuads * 6) {
+        int base = static_cast<int>(indices.size() / 6) * 4;
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    // Textured quads blend by the texture's mode, untextured ones by the renderer's
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (size_t i = 0; i < groupCount; ++i) {
+        const Group& group = groups[i];
+        if (group.quadCount == 0) {
+            continue;
+        }
+        if (SDL_RenderGeometry(renderer, group.texture,
+                               group.vertices.data(), static_cast<int>(group.quadCount * 4),
+                               indices.data(), static_cast<int>(group.quadCount * 6)) != 0) {
+            cerr << "SDL_RenderGeometry failed: " << SDL_GetError() << endl;
+        }
+        ++drawCalls;
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    clear();
+}
@@ -0,0 +1,166 @@
+#include "TextRenderer.h"
+
+#include <algorithm>
+#include <iostream>
+
+
+TextRenderer::TextRenderer() : atlas(nullptr), glyphs(), lineHeight(0) {}
+
+TextRenderer::~TextRenderer() {
+    destroy();
+}
+
+bool TextRenderer::init(SDL_Renderer* renderer, TTF_Font* font) {
+    destroy();
+
+    constexpr int glyphCount = LAST_GLYPH - FIRST_GLYPH + 1;
+    constexpr int columns = 16;
+    constexpr int rows = (glyphCount + columns - 1) / columns;
+
+    // Render every glyph first so the atlas cell can fit the widest one
+    SDL_Surface* glyphSurfaces[glyphCount] = {};
+    SDL_Color white = {255, 255, 255, 255};
+    int cellWidth = 1;
+    lineHeight = TTF_FontHeight(font);
+    for (int i = 0; i < glyphCount; ++i) {
+        glyphSurfaces[i] = TTF_RenderGlyph_Solid(font, static_cast<Uint16>(FIRST_GLYPH + i), white);
+        if (glyphSurfaces[i]) {
+            cellWidth = max(cellWidth, glyphSurfaces[i]->w);
+            lineHeight = max(lineHeight, glyphSurfaces[i]->h);
+        }
+    }
+
+    int atlasWidth = columns * cellWidth;
+    int atlasHeight = rows * lineHeight;
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        cerr << "Failed to create glyph atlas! SDL_Error: " << SDL_GetError() << endl;
+        for (SDL_Surface* surface : glyphSurfaces) {
+            SDL_FreeSurface(surface);
+        }
+        return false;
+    }
+    SDL_FillRect(atlasSurface, nullptr, SDL_MapRGBA(atlasSurface->format, 0, 0, 0, 0));
+
+    for (int i = 0; i < glyphCount; ++i) {
+        SDL_Rect cell = {(i % columns) * cellWidth, (i / columns) * lineHeight, 0, 0};
+        int width = 0;
+        if (glyphSurfaces[i]) {
+            width = glyphSurfaces[i]->w;
+            cell.w = glyphSurfaces[i]->w;
+            cell.h = glyphSurfaces[i]->h;
+            SDL_SetSurfaceBlendMode(glyphSurfaces[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(glyphSurfaces[i], nullptr, atlasSurface, &cell);
+            SDL_FreeSurface(glyphSurfaces[i]);
+        }
+
+        glyphs[i].uv = {
+            static_cast<float>(cell.x) / atlasWidth,
+            static_cast<float>(cell.y) / atlasHeight,
+            static_cast<float>(width) / atlasWidth,
+            static_cast<float>(lineHeight) / atlasHeight
+        };
+        glyphs[i].width = width;
+    }
+
+    atlas = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+    if (!atlas) {
+        cerr << "Failed to upload glyph atlas! SDL_Error: " << SDL_GetError() << endl;
+        return false;
+    }
+    SDL_SetTextureBlendMode(atlas, SDL_BLENDMODE_BLEND);
+
+    return true;
+}
+
+void TextRenderer::destroy() {
+    if (atlas) {
+        SDL_DestroyTexture(atlas);
+        atlas = nullptr;
+    }
+    layouts.clear();
+}
+
+const TextRenderer::TextLayout& TextRenderer::layout(const string& text) {
+    auto it = layouts.find(text);
+    if (it != layouts.end()) {
+        return it->second;
+    }
+
+    // Strings with changing numbers would otherwise grow the cache forever
+    if (layouts.size() >= MAX_CACHED_LAYOUTS) {
+        layouts.clear();
+    }
+
+    TextLayout& result = layouts[text];
+    result.vertices.reserve(text.size() * 4);
+    float penX = 0.0f;
+    float h = static_cast<float>(lineHeight);
+    for (unsigned char c : text) {
+        if (c < FIRST_GLYPH || c > LAST_GLYPH) {
+            c = '?';
+        }
+        const Glyph& glyph = glyphs[c - FIRST_GLYPH];
+        if (c != ' ' && glyph.width > 0) {
+            float w = static_cast<float>(glyph.width);
+            const SDL_FRect& uv = glyph.uv;
+            SDL_Color white = {255, 255, 255, 255};
+            result.vertices.push_back({{penX, 0.0f}, white, {uv.x, uv.y}});
+            result.vertices.push_back({{penX + w, 0.0f}, white, {uv.x + uv.w, uv.y}});
+            result.vertices.push_back({{penX + w, h}, white, {uv.x + uv.w, uv.y + uv.h}});
+            result.vertices.push_back({{penX, h}, white, {uv.x, uv.y + uv.h}});
+        }
+        penX += glyph.width;
+    }
+    result.width = static_cast<int>(penX);
+
+    return result;
+}
+
+void TextRenderer::draw(SDL_Renderer* renderer, const string& text, int x, int y, SDL_Color color) {
+    if (!atlas || text.empty()) {
+        return;
+    }
+
+    const TextLayout& cached = layout(text);
+    size_t vertexCount = cached.vertices.size();
+    if (vertexCount == 0) {
+        return;
+    }
+
+    // Shift the cached quads into place and apply the colour
+    scratch.resize(vertexCount);
+    float offsetX = static_cast<float>(x);
+    float offsetY = static_cast<float>(y);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        scratch[i].position = {cached.vertices[i].position.x + offsetX, cached.vertices[i].position.y + offsetY};
+        scratch[i].color = color;
+        scratch[i].tex_coord = cached.vertices[i].tex_coord;
+    }
+
+    size_t quadCount = vertexCount / 4;
+    while (indices.size() < quadCount * 6) {
+        int base = static_cast<int>(indices.size() / 6) * 4;
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    SDL_RenderGeometry(renderer, atlas, scratch.data(), static_cast<int>(vertexCount),
+                       indices.data(), static_cast<int>(quadCount * 6));
+}
+
+int TextRenderer::textWidth(const string& text) {
+    if (!atlas || text.empty()) {
+        return 0;
+    }
+    return layout(text).width;
+}
+
+int TextRenderer::textHeight() const {
+    return lineHeight;
+}
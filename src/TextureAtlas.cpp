@@ -0,0 +1,140 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <iostream>
+
+// Transparent gap between images so filtering never samples a neighbour
+constexpr int ATLAS_PADDING = 1;
+
+TextureAtlas::TextureAtlas(int maxPageSize_) : maxPageSize(maxPageSize_) {}
+
+void TextureAtlas::setMaxPageSize(int size) {
+    maxPageSize = size;
+}
+
+bool TextureAtlas::add(int id, SDL_Surface* surface) {
+    if (!surface || surface->w > maxPageSize || surface->h > maxPageSize) {
+        return false;
+    }
+    pending.push_back({id, surface});
+    return true;
+}
+
+bool TextureAtlas::hasPending() const {
+    return !pending.empty();
+}
+
+vector<TextureAtlas::Placement> TextureAtlas::build(SDL_Renderer* renderer) {
+    struct Shelf {
+        int y, height, x;
+    };
+    struct PageLayout {
+        vector<Shelf> shelves;
+        int width, height;
+        vector<pair<size_t, SDL_Rect>> images; // Index into pending, position on the page
+    };
+
+    // Tallest first keeps shelves full; ties broken by id so the layout is
+    // the same whatever order the loader threads finished in
+    sort(pending.begin(), pending.end(), [](const PendingImage& a, const PendingImage& b) {
+        if (a.surface->h != b.surface->h) return a.surface->h > b.surface->h;
+        if (a.surface->w != b.surface->w) return a.surface->w > b.surface->w;
+        return a.id < b.id;
+    });
+
+    vector<PageLayout> layouts;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        int w = pending[i].surface->w;
+        int h = pending[i].surface->h;
+        bool placed = false;
+
+        for (auto& layout : layouts) {
+            for (auto& shelf : layout.shelves) {
+                if (h <= shelf.height && shelf.x + w <= maxPageSize) {
+                    layout.images.push_back({i, {shelf.x, shelf.y, w, h}});
+                    shelf.x += w + ATLAS_PADDING;
+                    layout.width = max(layout.width, shelf.x - ATLAS_PADDING);
+                    placed = true;
+                    break;
+                }
+            }
+            if (placed) {
+                break;
+            }
+
+            int shelfY = layout.height == 0 ? 0 : layout.height + ATLAS_PADDING;
+            if (shelfY + h <= maxPageSize) {
+                layout.shelves.push_back({shelfY, h, w + ATLAS_PADDING});
+                layout.images.push_back({i, {0, shelfY, w, h}});
+                layout.width = max(layout.width, w);
+                layout.height = shelfY + h;
+                placed = true;
+                break;
+            }
+        }
+
+        if (!placed) {
+            PageLayout layout;
+            layout.shelves.push_back({0, h, w + ATLAS_PADDING});
+            layout.images.push_back({i, {0, 0, w, h}});
+            layout.width = w;
+            layout.height = h;
+            layouts.push_back(layout);
+        }
+    }
+
+    vector<Placement> placements;
+    for (const auto& layout : layouts) {
+        // Pages are only as big as what landed on them
+        SDL_Texture* page = nullptr;
+        SDL_Surface* pageSurface = SDL_CreateRGBSurfaceWithFormat(0, layout.width, layout.height,
+                                                                  32, SDL_PIXELFORMAT_RGBA32);
+        if (pageSurface) {
+            for (const auto& image : layout.images) {
+                SDL_Surface* source = pending[image.first].surface;
+                SDL_Rect dest = image.second;
+                // Copy alpha as-is instead of blending onto the empty page
+                SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(source, nullptr, pageSurface, &dest);
+            }
+
+            page = SDL_CreateTextureFromSurface(renderer, pageSurface);
+            SDL_FreeSurface(pageSurface);
+        }
+
+        if (page) {
+            SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+            pages.push_back(page);
+        } else {
+            cerr << "Unable to create atlas page " << layout.width << "x" << layout.height
+                 << "! SDL Error: " << SDL_GetError() << endl;
+        }
+
+        for (const auto& image : layout.images) {
+            placements.push_back({pending[image.first].id, {page, image.second}});
+        }
+    }
+
+    for (auto& image : pending) {
+        SDL_FreeSurface(image.surface);
+    }
+    pending.clear();
+
+    return placements;
+}
+
+int TextureAtlas::pageCount() const {
+    return static_cast<int>(pages.size());
+}
+
+void TextureAtlas::destroy() {
+    for (auto& image : pending) {
+        SDL_FreeSurface(image.surface);
+    }
+    pending.clear();
+
+    for (auto page : pages) {
+        SDL_DestroyTexture(page);
+    }
+    pages.clear();
+}
@@ -0,0 +1,255 @@
+#include "VoiceManager.h"
+
+#include <iostream>
+
+namespace {
+
+const int TOP_PRIORITY = 3;
+
+struct SoundRule {
+    int priority;   // Higher wins a channel
+    int maxVoices;  // Copies allowed to play at once
+};
+
+SoundRule ruleFor(SoundId sound) {
+    switch (sound) {
+    case SoundId::BUTTON_HOVER:      return {1, 1};
+    case SoundId::SHOOT:             return {1, 3};
+    case SoundId::RAPID_FIRE:        return {2, 1};
+    case SoundId::EXPLOSION:         return {2, 4};
+    case SoundId::POWERUP:           return {3, 2};
+    case SoundId::SHIELD_ACTIVATE:   return {3, 1};
+    case SoundId::SHIELD_DEACTIVATE: return {3, 1};
+    case SoundId::HEAL:              return {3, 1};
+    case SoundId::START_GAME:        return {3, 1};
+    default:                         return {1, 1};
+    }
+}
+
+} // namespace
+
+bool VoiceManager::initialized = false;
+SDL_SpinLock VoiceManager::lock = 0;
+VoiceManager::Request VoiceManager::requests[SOUND_COUNT] = {};
+VoiceManager::Voice VoiceManager::voices[AUDIO_VOICES] = {};
+SDL_atomic_t VoiceManager::finishes[AUDIO_VOICES] = {};
+SDL_atomic_t VoiceManager::failedStarts = {};
+AudioCommandQueue VoiceManager::commands;
+Uint32 VoiceManager::nextStartOrder = 0;
+VoiceStats VoiceManager::totals = {};
+
+void VoiceManager::init() {
+    if (initialized) {
+        return;
+    }
+
+    if (Mix_AllocateChannels(AUDIO_VOICES) < AUDIO_VOICES) {
+        cerr << "Unable to allocate " << AUDIO_VOICES << " mixer channels! SDL_mixer Error: " << Mix_GetError() << endl;
+    }
+    for (int channel = 0; channel < AUDIO_VOICES; ++channel) {
+        voices[channel] = {-1, 0, 0, 0};
+        SDL_AtomicSet(&finishes[channel], 0);
+    }
+    SDL_AtomicSet(&failedStarts, 0);
+    commands.clear();
+    totals = {};
+
+    Mix_ChannelFinished(channelFinished);
+    Mix_SetPostMix(drainCommands, nullptr);
+    initialized = true;
+}
+
+void VoiceManager::shutdown() {
+    if (!initialized) {
+        return;
+    }
+
+    // With the hooks gone the audio thread no longer touches the queue
+    Mix_SetPostMix(nullptr, nullptr);
+    Mix_ChannelFinished(nullptr);
+    Mix_HaltChannel(-1);
+    commands.clear();
+
+    SDL_AtomicLock(&lock);
+    for (Request& request : requests) {
+        request = {nullptr, 0, 0, 0};
+    }
+    SDL_AtomicUnlock(&lock);
+    initialized = false;
+}
+
+void VoiceManager::play(SoundId sound, Mix_Chunk* chunk) {
+    if (!initialized || !chunk) {
+        return;
+    }
+
+    SDL_AtomicLock(&lock);
+    Request& request = requests[static_cast<int>(sound)];
+    request.chunk = chunk;
+    request.count++;
+    SDL_AtomicUnlock(&lock);
+}
+
+void VoiceManager::endTick() {
+    if (!initialized) {
+        return;
+    }
+
+    SDL_AtomicLock(&lock);
+    for (Request& request : requests) {
+        if (request.count > 0) {
+            request.ticks++;
+            request.requests += request.count;
+            request.count = 0;
+        }
+    }
+    SDL_AtomicUnlock(&lock);
+}
+
+void VoiceManager::update() {
+    if (!initialized) {
+        return;
+    }
+
+    // Requests from a tick still in progress wait for its endTick()
+    Request pending[SOUND_COUNT];
+    SDL_AtomicLock(&lock);
+    for (int i = 0; i < SOUND_COUNT; ++i) {
+        pending[i] = requests[i];
+        requests[i].ticks = 0;
+        requests[i].requests = 0;
+    }
+    SDL_AtomicUnlock(&lock);
+
+    // Most important sounds first, so they steal before lesser ones can
+    for (int priority = TOP_PRIORITY; priority >= 0; --priority) {
+        for (int sound = 0; sound < SOUND_COUNT; ++sound) {
+            const Request& request = pending[sound];
+            if (request.ticks == 0 || ruleFor(static_cast<SoundId>(sound)).priority != priority) {
+                continue;
+            }
+            totals.requested += request.requests;
+            totals.coalesced += request.requests - request.ticks;
+            for (int tick = 0; tick < request.ticks; ++tick) {
+                start(sound, request.chunk);
+            }
+        }
+    }
+}
+
+void VoiceManager::setVolume(int volume) {
+    if (!initialized) {
+        return;
+    }
+    if (!commands.push({AudioCommand::VOLUME, -1, nullptr, volume})) {
+        cerr << "Unable to queue volume change, audio command queue full!" << endl;
+    }
+}
+
+bool VoiceManager::isBusy(int channel) {
+    // Until the audio thread reports every voice started here as finished
+    return SDL_AtomicGet(&finishes[channel]) != voices[channel].starts;
+}
+
+void VoiceManager::start(int sound, Mix_Chunk* chunk) {
+    SoundRule rule = ruleFor(static_cast<SoundId>(sound));
+
+    // At its cap a sound restarts its own oldest copy
+    int copies = 0;
+    int oldestCopy = -1;
+    int freeChannel = -1;
+    bool busy[AUDIO_VOICES];
+    for (int channel = 0; channel < AUDIO_VOICES; ++channel) {
+        const Voice& voice = voices[channel];
+        busy[channel] = isBusy(channel);
+        if (!busy[channel]) {
+            if (freeChannel < 0) {
+                freeChannel = channel;
+            }
+        } else if (voice.sound == sound) {
+            ++copies;
+            if (oldestCopy < 0 || voice.startOrder < voices[oldestCopy].startOrder) {
+                oldestCopy = channel;
+            }
+        }
+    }
+    if (copies >= rule.maxVoices) {
+        totals.stolen++;
+        playOn(oldestCopy, sound, chunk);
+        return;
+    }
+    if (freeChannel >= 0) {
+        playOn(freeChannel, sound, chunk);
+        return;
+    }
+
+    // Every channel busy: take the lowest-priority voice, oldest first, unless it outranks this sound
+    int victim = -1;
+    for (int channel = 0; channel < AUDIO_VOICES; ++channel) {
+        const Voice& voice = voices[channel];
+        if (!busy[channel]) {
+            continue;
+        }
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.startOrder < voices[victim].startOrder)) {
+            victim = channel;
+        }
+    }
+    if (voices[victim].priority > rule.priority) {
+        totals.dropped++;
+        return;
+    }
+    totals.stolen++;
+    playOn(victim, sound, chunk);
+}
+
+void VoiceManager::playOn(int channel, int sound, Mix_Chunk* chunk) {
+    // Starting on a busy channel cuts off whatever was there
+    if (!commands.push({AudioCommand::PLAY, channel, chunk, 0})) {
+        totals.dropped++;
+        return;
+    }
+    Voice& voice = voices[channel];
+    voice.sound = sound;
+    voice.priority = ruleFor(static_cast<SoundId>(sound)).priority;
+    voice.startOrder = nextStartOrder++;
+    voice.starts++;
+    totals.started++;
+}
+
+void SDLCALL VoiceManager::drainCommands(void*, Uint8*, int) {
+    // Called from the mixing callback, so SDL_mixer's lock is already held
+    // by this thread and the Mix_ calls below take it without waiting
+    commands.drain(applyCommand);
+}
+
+void VoiceManager::applyCommand(const AudioCommand& command) {
+    switch (command.type) {
+    case AudioCommand::PLAY:
+        if (Mix_PlayChannel(command.channel, command.chunk, 0) < 0) {
+            // Nothing started, so no finished callback will balance the start
+            SDL_AtomicAdd(&finishes[command.channel], 1);
+            SDL_AtomicAdd(&failedStarts, 1);
+        }
+        break;
+    case AudioCommand::VOLUME:
+        Mix_Volume(command.channel, command.volume);
+        break;
+    }
+}
+
+void SDLCALL VoiceManager::channelFinished(int channel) {
+    // Also called when a PLAY cuts off a voice, so every start gets exactly one
+    if (channel >= 0 && channel < AUDIO_VOICES) {
+        SDL_AtomicAdd(&finishes[channel], 1);
+    }
+}
+
+VoiceStats VoiceManager::stats() {
+    // Starts the mixer refused only show up once the audio thread tried them
+    VoiceStats result = totals;
+    int failed = SDL_AtomicGet(&failedStarts);
+    result.started -= failed;
+    result.dropped += failed;
+    return result;
+}
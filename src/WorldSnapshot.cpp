@@ -0,0 +1,90 @@
+#include "WorldSnapshot.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+
+namespace {
+    const int FRESH_SLOT = 4;  // Set in latest until the renderer takes the slot
+    const int SLOT_MASK = 3;
+}
+
+WorldSnapshot::WorldSnapshot()
+    : time(0), publishCounter(0), tickCounter(1), publishAlpha(0.0f),
+      cameraX(0), cameraY(0), prevCameraX(0), prevCameraY(0),
+      player(MAP_WIDTH / 2.0f, MAP_HEIGHT / 2.0f, nullptr),
+      particles(MAX_PARTICLES),
+      stats(), rapidFire(), healthRegenInfo(), shieldStartTime(0), shieldCooldownRemaining(0) {}
+
+float WorldSnapshot::alphaAt(Uint64 counter) const {
+    // Past the next tick the simulation is late; hold the newest state
+    double elapsed = counter > publishCounter ? static_cast<double>(counter - publishCounter) / tickCounter : 0.0;
+    return static_cast<float>(min(1.0, publishAlpha + elapsed));
+}
+
+void WorldSnapshot::cull(const SDL_FRect& view, float alpha, VisibleSet& visible) const {
+    int enemiesCulled = enemies.cull(view, alpha, visible.enemies);
+    int bulletsCulled = bullets.cull(view, alpha, visible.bullets);
+    int particlesCulled = particles.cull(view, visible.particles);
+
+    // Power-ups pulse up to 10% past their 30px square
+    visible.powerups.clear();
+    int powerupsCulled = 0;
+    for (size_t i = 0; i < powerups.size(); ++i) {
+        if (!powerups[i].active) {
+            continue;
+        }
+        if (overlapsView(powerups[i].x, powerups[i].y, 17.0f, view)) {
+            visible.powerups.push_back(static_cast<int>(i));
+        } else {
+            ++powerupsCulled;
+        }
+    }
+
+    // Explosions start at their full size and shrink
+    visible.explosions.clear();
+    int explosionsCulled = 0;
+    for (size_t i = 0; i < explosions.size(); ++i) {
+        const Explosion& explosion = explosions[i];
+        if (!explosion.active) {
+            continue;
+        }
+        float extent = EXPLOSION_RADIUS * (explosion.isSpecial ? 2.0f : 1.0f);
+        if (overlapsView(explosion.x, explosion.y, extent, view)) {
+            visible.explosions.push_back(static_cast<int>(i));
+        } else {
+            ++explosionsCulled;
+        }
+    }
+
+    Profiler::count(ProfileCounter::ENEMIES_DRAWN, static_cast<int>(visible.enemies.size()));
+    Profiler::count(ProfileCounter::ENEMIES_CULLED, enemiesCulled);
+    Profiler::count(ProfileCounter::BULLETS_DRAWN, static_cast<int>(visible.bullets.size()));
+    Profiler::count(ProfileCounter::BULLETS_CULLED, bulletsCulled);
+    Profiler::count(ProfileCounter::PARTICLES_DRAWN, static_cast<int>(visible.particles.size()));
+    Profiler::count(ProfileCounter::PARTICLES_CULLED, particlesCulled);
+    Profiler::count(ProfileCounter::POWERUPS_DRAWN, static_cast<int>(visible.powerups.size()));
+    Profiler::count(ProfileCounter::POWERUPS_CULLED, powerupsCulled);
+    Profiler::count(ProfileCounter::EXPLOSIONS_DRAWN, static_cast<int>(visible.explosions.size()));
+    Profiler::count(ProfileCounter::EXPLOSIONS_CULLED, explosionsCulled);
+}
+
+SnapshotBuffer::SnapshotBuffer() : writeSlot(0), readSlot(1) {
+    SDL_AtomicSet(&latest, 2);
+}
+
+WorldSnapshot& SnapshotBuffer::back() {
+    return slots[writeSlot];
+}
+
+void SnapshotBuffer::publish() {
+    // Swap the filled slot in as the newest and take back whichever slot it replaced
+    writeSlot = SDL_AtomicSet(&latest, writeSlot | FRESH_SLOT) & SLOT_MASK;
+}
+
+WorldSnapshot& SnapshotBuffer::acquire() {
+    if (SDL_AtomicGet(&latest) & FRESH_SLOT) {
+        readSlot = SDL_AtomicSet(&latest, readSlot) & SLOT_MASK;
+    }
+    return slots[readSlot];
+}
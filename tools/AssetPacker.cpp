@@ -0,0 +1,180 @@
+// Offline asset packer: bakes images into RGBA32 blobs, sound effects into
+// PCM in the game's mixer format, and copies music and fonts verbatim.
+// Usage: asset_packer <output.pack> <asset paths...>
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_mixer.h>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "AssetPack.h"
+
+using namespace std;
+
+// Must match Mix_OpenAudio in Game::run so the PCM can be played as-is
+constexpr int MIXER_FREQUENCY = 44100;
+constexpr Uint16 MIXER_FORMAT = MIX_DEFAULT_FORMAT;
+constexpr int MIXER_CHANNELS = 2;
+
+static bool endsWith(const string& text, const string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool readFile(const string& path, vector<Uint8>& bytes) {
+    SDL_RWops* file = SDL_RWFromFile(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    Sint64 size = SDL_RWsize(file);
+    bytes.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    size_t read = bytes.empty() ? 0 : SDL_RWread(file, bytes.data(), 1, bytes.size());
+    SDL_RWclose(file);
+    return read == bytes.size();
+}
+
+static void appendAligned(vector<Uint8>& blob, const void* data, size_t size) {
+    while (blob.size() % 16 != 0) {
+        blob.push_back(0);
+    }
+    const Uint8* bytes = static_cast<const Uint8*>(data);
+    blob.insert(blob.end(), bytes, bytes + size);
+}
+
+// Music is streamed at runtime and fonts are parsed by SDL_ttf, so those stay as files
+static bool isRawAsset(const string& path) {
+    return endsWith(path, ".ttf") || path.find("music") != string::npos;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "Usage: " << argv[0] << " <output.pack> <asset paths...>" << endl;
+        return 1;
+    }
+
+    // No audio device is needed to decode; the dummy driver keeps this headless
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << endl;
+        return 1;
+    }
+    IMG_Init(IMG_INIT_PNG);
+    Mix_Init(MIX_INIT_MP3);
+    if (Mix_OpenAudio(MIXER_FREQUENCY, MIXER_FORMAT, MIXER_CHANNELS, 2048) < 0) {
+        cerr << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << endl;
+        SDL_Quit();
+        return 1;
+    }
+
+    int frequency = 0;
+    Uint16 format = 0;
+    int channels = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+
+    vector<Uint8> blob(sizeof(AssetPackHeader), 0);
+    vector<AssetPackEntry> toc;
+    int failures = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        string path = argv[i];
+        if (path.size() >= ASSET_PACK_NAME_LENGTH) {
+            cerr << "Skipping " << path << ": name too long" << endl;
+            failures++;
+            continue;
+        }
+
+        AssetPackEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        strncpy(entry.name, path.c_str(), ASSET_PACK_NAME_LENGTH - 1);
+
+        if (endsWith(path, ".png")) {
+            SDL_Surface* loaded = IMG_Load(path.c_str());
+            SDL_Surface* rgba = loaded ? SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA32, 0) : nullptr;
+            SDL_FreeSurface(loaded);
+            if (!rgba) {
+                cerr << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << endl;
+                failures++;
+                continue;
+            }
+
+            // Drop any row padding so the blob can be uploaded with pitch = width * 4
+            vector<Uint8> pixels(static_cast<size_t>(rgba->w) * rgba->h * 4);
+            for (int y = 0; y < rgba->h; ++y) {
+                memcpy(&pixels[static_cast<size_t>(y) * rgba->w * 4],
+                       static_cast<Uint8*>(rgba->pixels) + y * rgba->pitch, rgba->w * 4);
+            }
+
+            entry.type = PACK_TEXTURE_RGBA32;
+            entry.param0 = rgba->w;
+            entry.param1 = rgba->h;
+            entry.size = static_cast<Uint32>(pixels.size());
+            appendAligned(blob, pixels.data(), pixels.size());
+            entry.offset = static_cast<Uint32>(blob.size() - pixels.size());
+            SDL_FreeSurface(rgba);
+        } else if (!isRawAsset(path) && (endsWith(path, ".mp3") || endsWith(path, ".wav") || endsWith(path, ".ogg"))) {
+            Mix_Chunk* chunk = Mix_LoadWAV(path.c_str());
+            if (!chunk) {
+                cerr << "Unable to load sound " << path << "! SDL_mixer Error: " << Mix_GetError() << endl;
+                failures++;
+                continue;
+            }
+
+            entry.type = PACK_AUDIO_PCM;
+            entry.param0 = frequency;
+            entry.param1 = format;
+            entry.param2 = channels;
+            entry.size = chunk->alen;
+            appendAligned(blob, chunk->abuf, chunk->alen);
+            entry.offset = static_cast<Uint32>(blob.size() - chunk->alen);
+            Mix_FreeChunk(chunk);
+        } else {
+            vector<Uint8> bytes;
+            if (!readFile(path, bytes)) {
+                cerr << "Unable to read " << path << endl;
+                failures++;
+                continue;
+            }
+
+            entry.type = PACK_RAW_FILE;
+            entry.size = static_cast<Uint32>(bytes.size());
+            appendAligned(blob, bytes.data(), bytes.size());
+            entry.offset = static_cast<Uint32>(blob.size() - bytes.size());
+        }
+
+        toc.push_back(entry);
+    }
+
+    // Table of contents goes last, so entry offsets are known when it is written
+    while (blob.size() % 16 != 0) {
+        blob.push_back(0);
+    }
+    AssetPackHeader header;
+    memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = static_cast<Uint32>(toc.size());
+    header.tocOffset = static_cast<Uint32>(blob.size());
+    memcpy(blob.data(), &header, sizeof(header));
+    const Uint8* tocBytes = reinterpret_cast<const Uint8*>(toc.data());
+    blob.insert(blob.end(), tocBytes, tocBytes + toc.size() * sizeof(AssetPackEntry));
+
+    FILE* out = fopen(argv[1], "wb");
+    bool written = out && fwrite(blob.data(), 1, blob.size(), out) == blob.size();
+    if (out) {
+        fclose(out);
+    }
+    if (!written) {
+        cerr << "Unable to write " << argv[1] << endl;
+        failures++;
+    } else {
+        cout << "Packed " << toc.size() << " assets into " << argv[1] << " (" << blob.size() << " bytes)" << endl;
+    }
+
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return failures == 0 ? 0 : 1;
+}